@@ -4,22 +4,94 @@
 
 #include "include/analyzer.hpp"
 
+#include <mutex>
+#include <thread>
+
 using namespace XC;
 
+// Below this many functions a job takes less to validate than a thread takes to start
+static constexpr uint32_t MIN_FUNCTIONS_PER_JOB = 256;
+
+// A run of functions, from the front of which its worker takes the next one
+// and from the back of which idle workers steal
+struct Analyzer::Job {
+    std::mutex lock;
+    uint32_t from;
+    uint32_t to;
+
+    std::unique_ptr<Analyzer> analyzer;
+};
+
 Analyzer::Analyzer(const std::unique_ptr<Module>& module)
     : module(module),
-      symbol_table(std::make_unique<SymbolTable>()),
+      owned_table(std::make_unique<SymbolTable>()),
+      symbol_table(owned_table.get()),
+      flat(module->flat.get()),
+      owned_flat_table(module->flat != nullptr ? std::make_unique<FlatSymbolTable>() : nullptr),
+      flat_table(owned_flat_table.get()),
+      self_symbol(module->names.intern("self")),
+      bool_symbol(module->names.intern("bool")),
+      int_symbol(module->names.intern("int")),
+      float_symbol(module->names.intern("float")),
+      null_symbol(module->names.intern("null")),
+      types(module->types),
+      bool_type(types.get(bool_symbol, TokenType::TYPE_BOOL, "bool", false, 0)),
+      int_type(types.get(int_symbol, TokenType::TYPE_INT, "int", false, 0)),
+      float_type(types.get(float_symbol, TokenType::TYPE_FLOAT, "float", false, 0)),
+      null_type(types.get(null_symbol, TokenType::LITERAL_REFERENCE_NULL, "null", true, 0)),
+      symbol_stack(module->names.size()),
+      current_function(NO_NODE),
+      loop_depth(0),
+      reports(),
       has_error(false) {
     checkSemantics();
+
+    std::cerr << reports;
 }
 
+Analyzer::Analyzer(const Analyzer* parent)
+    : module(parent->module),
+      owned_table(),
+      symbol_table(parent->symbol_table),
+      flat(parent->flat),
+      owned_flat_table(),
+      flat_table(parent->flat_table),
+      self_symbol(parent->self_symbol),
+      bool_symbol(parent->bool_symbol),
+      int_symbol(parent->int_symbol),
+      float_symbol(parent->float_symbol),
+      null_symbol(parent->null_symbol),
+      types(module->types),
+      bool_type(parent->bool_type),
+      int_type(parent->int_type),
+      float_type(parent->float_type),
+      null_type(parent->null_type),
+      symbol_stack(module->names.size()),
+      current_function(NO_NODE),
+      loop_depth(0),
+      reports(),
+      has_error(false) {}
+
 void Analyzer::checkSemantics(void) {
+    if (flat != nullptr) {
+        loadFlatSymbols();
+        validateFlatStructures();
+
+        flat->evaluated_types.assign(flat->expressions.size(), nullptr);
+
+        validateFunctions();
+        return;
+    }
+
     // load declarations into symbol table
     // for each declaration 
     //   struct -> check members
     //   function -> check return type, identifier, parameters, statements
     loadSymbols();
     validateStructures();
+
+    module->fingerprints = module->options.incremental ? std::make_unique<Fingerprints>(module, *symbol_table) : nullptr;
+
     validateFunctions();
 }
 
@@ -27,18 +99,18 @@ void Analyzer::loadSymbols(void) {
     for (Declaration*& declaration : module->program->declarations) {
         if (Function* function = get_node_if(declaration, Function)) {
             if (!symbol_table->loadFunction(function)) {
-                error("function `" + function->name->lexeme + "` is already defined", function->name);
+                error("function `" + std::string(function->name->lexeme) + "` is already defined", function->name);
             }
         } else if (Structure* structure = get_node_if(declaration, Structure)) {
             if (!symbol_table->loadStructure(structure)) {
-                error("struct `" + structure->name->lexeme + "` already defined", structure->name);
+                error("struct `" + std::string(structure->name->lexeme) + "` already defined", structure->name);
             }
         }
     }
 }
 
 void Analyzer::validateStructures(void) {
-    const std::vector<Structure*> structures = symbol_table->getAllStructures();
+    const std::vector<Structure*>& structures = symbol_table->getAllStructures();
 
     // for each structure ->
     //   validate members ->
@@ -49,43 +121,175 @@ void Analyzer::validateStructures(void) {
 }
 
 void Analyzer::validateFunctions(void) {
-    const std::vector<Function*> functions = symbol_table->getAllFunctions();
+    const uint32_t count = functionCount();
+
+    const uint32_t jobs_fitting = max_of(count / MIN_FUNCTIONS_PER_JOB, 1);
+    const uint32_t job_count = min_of(module->options.jobs, jobs_fitting);
+
+    if (job_count > 1) {
+        validateFunctionsInParallel(job_count);
+        return;
+    }
+
+    for (uint32_t index = 0; index < count; ++index) {
+        validateFunction(index);
+    }
+}
+
+void Analyzer::validateFunctionsInParallel(const uint32_t job_count) {
+    const uint32_t count = functionCount();
+
+    // Functions only read the symbol table and the declarations, and write
+    // types into their own expressions, so any worker can take any of them.
+    // Workers start on even runs and steal once theirs is done, since bodies
+    // differ widely in how long they take.
+    std::deque<Job> jobs;
+
+    for (uint32_t i = 0; i < job_count; ++i) {
+        Job& job = jobs.emplace_back();
+        job.from = (uint64_t) count * i / job_count;
+        job.to = (uint64_t) count * (i + 1) / job_count;
+        job.analyzer.reset(new Analyzer(this));
+    }
+
+    // Reports are kept per function so they come out in the order of the
+    // source, whichever worker validated it
+    std::vector<std::string> function_reports(count);
+    {
+        std::vector<std::thread> workers;
+
+        for (Job& job : jobs) {
+            workers.emplace_back([&jobs, &job, &function_reports] {
+                Analyzer& analyzer = *job.analyzer;
+                uint32_t index;
+
+                while (takeFunction(jobs, job, index)) {
+                    analyzer.validateFunction(index);
+                    function_reports[index].swap(analyzer.reports);
+                }
+            });
+        }
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    for (const std::string& function_report : function_reports) {
+        reports.append(function_report);
+    }
+
+    for (const Job& job : jobs) {
+        has_error = has_error || job.analyzer->has_error;
+    }
+}
+
+bool Analyzer::takeFunction(std::deque<Job>& jobs, Job& own, uint32_t& index) {
+    {
+        const std::lock_guard<std::mutex> guard(own.lock);
+
+        if (own.from < own.to) {
+            index = own.from++;
+            return true;
+        }
+    }
+
+    // Steals the back half of the job with the most left, looking again if
+    // its worker got through it in the meantime
+    while (true) {
+        Job* victim = nullptr;
+        uint32_t most_left = 0;
+
+        for (Job& job : jobs) {
+            const std::lock_guard<std::mutex> guard(job.lock);
+
+            if (job.to - job.from > most_left) {
+                victim = &job;
+                most_left = job.to - job.from;
+            }
+        }
+
+        if (victim == nullptr) {
+            return false;
+        }
+
+        uint32_t from;
+        uint32_t to;
+        {
+            const std::lock_guard<std::mutex> guard(victim->lock);
+
+            if (victim->from == victim->to) {
+                continue;
+            }
+
+            to = victim->to;
+            from = victim->to - (victim->to - victim->from + 1) / 2;
+            victim->to = from;
+        }
+
+        const std::lock_guard<std::mutex> guard(own.lock);
+        own.from = from + 1;
+        own.to = to;
 
-    for (const Function* function : functions) {
-        validateFunctionOwner(function);
-        validateFunctionReturnType(function);
-        validateFunctionParameters(function);
-        validateFunctionBody(function);
+        index = from;
+        return true;
+    }
+}
+
+void Analyzer::validateFunction(const uint32_t index) {
+    if (flat != nullptr) {
+        validateFlatFunction(flat_table->getAllFunctions()[index]);
+        return;
+    }
+
+    const Function* function = symbol_table->getAllFunctions()[index];
+
+    Fingerprints* fingerprints = module->fingerprints.get();
+
+    // Its code is reused as well, so it needs no types either
+    if (fingerprints != nullptr && fingerprints->reuse(index)) {
+        return;
+    }
+
+    const size_t reported = reports.size();
+
+    validateFunctionOwner(function);
+    validateFunctionReturnType(function);
+    validateFunctionParameters(function);
+    validateFunctionBody(function);
+
+    if (fingerprints != nullptr && reports.size() == reported) {
+        fingerprints->validated(index);
     }
 }
 
 void Analyzer::validateStructureMember(const Structure* structure) {
-    std::unordered_set<std::string> member_table;
+    std::unordered_set<SymbolId> member_table;
 
     for (const VariableDeclarator* member : structure->members->members) {
         const DataType* member_type = member->data_type;
         const IdentifierToken* member_identifier = member->variable_name;
 
         if (member_type->type_name->type == TokenType::IDENTIFIER) {
-            const Structure* symbol = symbol_table->lookupStructure(member_type->type_name->lexeme);
+            const Structure* symbol = symbol_table->lookupStructure(member_type->type_name->symbol);
             
             if (symbol == nullptr) {
-                error("type `" + member_type->type_name->lexeme + "` is undefined", member_type->type_name);
+                error("type `" + std::string(member_type->type_name->lexeme) + "` is undefined", member_type->type_name);
             } else {
                 const bool contains_self = symbol == structure;
                 const bool has_non_direct_reference = member_type->is_reference || member_type->dimensions > 0;
                 const bool is_self_referencing = contains_self && !has_non_direct_reference;
 
                 if (is_self_referencing) {
-                    error("struct `" + structure->name->lexeme + "` contains a self referencing member" , member->variable_name);
+                    error("struct `" + std::string(structure->name->lexeme) + "` contains a self referencing member" , member->variable_name);
                 }
             }
         }
 
-        if (member_table.count(member_identifier->lexeme) <= 0) {
-            member_table.insert(member_identifier->lexeme);
+        if (member_table.count(member_identifier->symbol) <= 0) {
+            member_table.insert(member_identifier->symbol);
         } else {
-            error("struct `" + structure->name->lexeme + "` has multiple members of `" + member_identifier->lexeme + "`", member_identifier);
+            error("struct `" + std::string(structure->name->lexeme) + "` has multiple members of `" + std::string(member_identifier->lexeme) + "`", member_identifier);
         }
     }
 }
@@ -97,8 +301,8 @@ void Analyzer::validateFunctionOwner(const Function* function) {
         return;
     }
 
-    if (symbol_table->lookupStructure(owner->lexeme) == nullptr) {
-        error("struct `" + owner->lexeme + "` is undefined", owner);
+    if (symbol_table->lookupStructure(owner->symbol) == nullptr) {
+        error("struct `" + std::string(owner->lexeme) + "` is undefined", owner);
     }
 }
 
@@ -116,8 +320,8 @@ void Analyzer::validateFunctionReturnType(const Function* function) {
         return;
     }
 
-    if (symbol_table->lookupStructure(return_type->type_name->lexeme) == nullptr) {
-        error("struct `" + return_type->type_name->lexeme + "` is undefined", return_type->type_name);
+    if (symbol_table->lookupStructure(return_type->type_name->symbol) == nullptr) {
+        error("struct `" + std::string(return_type->type_name->lexeme) + "` is undefined", return_type->type_name);
     }
 }
 
@@ -129,11 +333,11 @@ void Analyzer::validateFunctionParameters(const Function* function) {
         return;
     }
 
-    std::unordered_set<std::string> parameter_table;
+    std::unordered_set<SymbolId> parameter_table;
 
     const bool has_owner = function->owner != nullptr;
     if (has_owner) {
-        parameter_table.insert("self");
+        parameter_table.insert(self_symbol);
     }
 
     for (const VariableDeclarator* parameter : parameters->parameters) {
@@ -141,15 +345,15 @@ void Analyzer::validateFunctionParameters(const Function* function) {
         const IdentifierToken* parameter_identifier = parameter->variable_name;
 
         if (parameter_type->type_name->type == TokenType::IDENTIFIER) {
-            if (symbol_table->lookupStructure(parameter_type->type_name->lexeme) == nullptr) {
-                error("type `" + parameter_type->type_name->lexeme + " is undefined", parameter_type->type_name);
+            if (symbol_table->lookupStructure(parameter_type->type_name->symbol) == nullptr) {
+                error("type `" + std::string(parameter_type->type_name->lexeme) + " is undefined", parameter_type->type_name);
             }
         }
 
-        if (parameter_table.count(parameter_identifier->lexeme) <= 0) {
-            parameter_table.insert(parameter_identifier->lexeme);
+        if (parameter_table.count(parameter_identifier->symbol) <= 0) {
+            parameter_table.insert(parameter_identifier->symbol);
         } else {
-            error("multiple parameter name of `" + parameter_identifier->lexeme + "`", parameter_identifier);
+            error("multiple parameter name of `" + std::string(parameter_identifier->lexeme) + "`", parameter_identifier);
         }
     }
 }
@@ -157,8 +361,6 @@ void Analyzer::validateFunctionParameters(const Function* function) {
 void Analyzer::validateFunctionBody(const Function* function) {
     const BlockStatement* body = function->body;
 
-    SymbolStack symbol_stack;
-
     symbol_stack.pushStack(function);
 
     pushParametersToStack(symbol_stack, function);
@@ -168,7 +370,7 @@ void Analyzer::validateFunctionBody(const Function* function) {
     symbol_stack.popStack();
 }
 
-DataType* Analyzer::getTypeOfExpression(SymbolStack& symbols, Expression* expression) {
+const DataType* Analyzer::getTypeOfExpression(SymbolStack& symbols, Expression* expression) {
     if (expression == nullptr) {
         return nullptr;
     }
@@ -177,29 +379,33 @@ DataType* Analyzer::getTypeOfExpression(SymbolStack& symbols, Expression* expres
         return expression->evaluated_type;
     }
 
-    if (PrefixUnaryExpression* prefix = get_node_if(expression, PrefixUnaryExpression)) {
-        expression->evaluated_type = getTypeOfPrefixExpression(symbols, prefix);
-    }
-    else if (PostfixUnaryExpression* postfix = get_node_if(expression,  PostfixUnaryExpression)) {
-        expression->evaluated_type = getTypeOfPostfixExpression(symbols, postfix);
-    }
-    else if (BinaryExpression* binary = get_node_if(expression, BinaryExpression)) {
-        expression->evaluated_type = getTypeOfBinaryExpression(symbols, binary);
-    }
-    else if (NumberConstant* number = get_node_if(expression, NumberConstant)) {
-        expression->evaluated_type = getTypeOfNumberExpression(number);
-    }
-    else if (IdentifierConstant* identifier = get_node_if(expression, IdentifierConstant)) {
-        expression->evaluated_type = getTypeOfIdentifier(symbols, identifier);
-    }
-    else if (LiteralExpression* literal = get_node_if(expression, LiteralExpression)) {
-        expression->evaluated_type = getTypeOfLiteral(literal);
-    } 
-    else if (MemberAccess* member_access = get_node_if(expression, MemberAccess)) {
-        expression->evaluated_type = getTypeOfMemberAccess(symbols, member_access);
-    }
-    else if (FunctionCall* function_call = get_node_if(expression, FunctionCall)) {
-        expression->evaluated_type = getTypeOfFunctionCall(symbols, function_call);
+    switch (expression->type()) {
+        case ASTType::PrefixUnaryExpression:
+            expression->evaluated_type = getTypeOfPrefixExpression(symbols, (PrefixUnaryExpression*) expression);
+            break;
+        case ASTType::PostfixUnaryExpression:
+            expression->evaluated_type = getTypeOfPostfixExpression(symbols, (PostfixUnaryExpression*) expression);
+            break;
+        case ASTType::BinaryExpression:
+            expression->evaluated_type = getTypeOfBinaryExpression(symbols, (BinaryExpression*) expression);
+            break;
+        case ASTType::NumberConstant:
+            expression->evaluated_type = getTypeOfNumberExpression((NumberConstant*) expression);
+            break;
+        case ASTType::IdentifierConstant:
+            expression->evaluated_type = getTypeOfIdentifier(symbols, (IdentifierConstant*) expression);
+            break;
+        case ASTType::LiteralExpression:
+            expression->evaluated_type = getTypeOfLiteral((LiteralExpression*) expression);
+            break;
+        case ASTType::MemberAccess:
+            expression->evaluated_type = getTypeOfMemberAccess(symbols, (MemberAccess*) expression);
+            break;
+        case ASTType::FunctionCall:
+            expression->evaluated_type = getTypeOfFunctionCall(symbols, (FunctionCall*) expression);
+            break;
+        default:
+            break;
     }
 
     return expression->evaluated_type;
@@ -212,116 +418,138 @@ void Analyzer::validateBlockStatement(SymbolStack& stack, const BlockStatement*
 }
 
 void Analyzer::validateStatement(SymbolStack& stack, const Statement* statement) {
-    if (const VariableDeclarationStatement* variable_declaration = get_node_if(statement, VariableDeclarationStatement)) {
-        const DataType* variable_type = variable_declaration->declarator->data_type;
-        const IdentifierToken* variable_name = variable_declaration->declarator->variable_name;
-        const Expression* initial_value = variable_declaration->initial;
+    switch (statement->type()) {
+        case ASTType::VariableDeclarationStatement: {
+            const VariableDeclarationStatement* variable_declaration = (const VariableDeclarationStatement*) statement;
 
-        // check type
-        if (variable_type->type_name->type == TokenType::IDENTIFIER) {
-            const Structure* symbol = symbol_table->lookupStructure(variable_type->type_name->lexeme);
+            const DataType* variable_type = variable_declaration->declarator->data_type;
+            const IdentifierToken* variable_name = variable_declaration->declarator->variable_name;
+            const Expression* initial_value = variable_declaration->initial;
 
-            if (symbol == nullptr) {
-                error("type `" + variable_type->type_name->lexeme + "` is undefined", variable_type->type_name);
+            // check type
+            if (variable_type->type_name->type == TokenType::IDENTIFIER) {
+                const Structure* symbol = symbol_table->lookupStructure(variable_type->type_name->symbol);
+
+                if (symbol == nullptr) {
+                    error("type `" + std::string(variable_type->type_name->lexeme) + "` is undefined", variable_type->type_name);
+                }
             }
-        }
 
-        // check name (not used already)
-        if (stack.lookupSymbol(variable_name->lexeme) != nullptr) {
-            error("variable name of `" + variable_name->lexeme + "` is already defined", variable_name);
-        } else {
-            stack.addSymbol(variable_name->lexeme, variable_type);
-        }
+            // check name (not used already)
+            if (stack.lookupSymbol(variable_name->symbol) != nullptr) {
+                error("variable name of `" + std::string(variable_name->lexeme) + "` is already defined", variable_name);
+            } else {
+                stack.addSymbol(variable_name->symbol, types.get(variable_type));
+            }
 
-        if (initial_value != nullptr) {
-            const DataType* initial_value_type = getTypeOfExpression(stack, (Expression*) initial_value);
+            if (initial_value != nullptr) {
+                const DataType* initial_value_type = getTypeOfExpression(stack, (Expression*) initial_value);
 
-            if (initial_value_type == nullptr) {
-                error("could not assign initial value", variable_name);
-                return;
-            }
+                if (initial_value_type == nullptr) {
+                    error("could not assign initial value", variable_name);
+                    return;
+                }
 
-            if (!isSameType(variable_type, initial_value_type)) {
-                error("`" + variable_name->lexeme + "` was declared as `" + variable_type->type_name->lexeme + "` but was initialize as `" + initial_value_type->type_name->lexeme + "`", variable_name);
+                if (!isSameType(types.get(variable_type), initial_value_type)) {
+                    error("`" + std::string(variable_name->lexeme) + "` was declared as `" + std::string(variable_type->type_name->lexeme) + "` but was initialize as `" + std::string(initial_value_type->type_name->lexeme) + "`", variable_name);
+                }
             }
+            break;
         }
-    }
-    else if (const ExpressionStatement* expression_statement = get_node_if(statement, ExpressionStatement)) {
-        getTypeOfExpression(stack, expression_statement->expression);
-    }
-    else if (const WhileIteration* while_iteration = get_node_if(statement, WhileIteration)) {
-        if (!isBooleanType(getTypeOfExpression(stack, while_iteration->condition))) {
-            error("while condition should evaluate to be bool", nullptr);
+        case ASTType::ExpressionStatement: {
+            const ExpressionStatement* expression_statement = (const ExpressionStatement*) statement;
+
+            getTypeOfExpression(stack, expression_statement->expression);
+            break;
         }
+        case ASTType::WhileIteration: {
+            const WhileIteration* while_iteration = (const WhileIteration*) statement;
 
-        stack.pushStack(while_iteration);
+            if (!isBooleanType(getTypeOfExpression(stack, while_iteration->condition))) {
+                error("while condition should evaluate to be bool", nullptr);
+            }
 
-        validateBlockStatement(stack, while_iteration->body);
+            stack.pushStack(while_iteration);
 
-        stack.popStack();
-    }
-    else if (const ForIteration* for_iteration = get_node_if(statement, ForIteration)) {
-        const VariableDeclarationStatement* initial = for_iteration->initial;
-        const Expression* condition = for_iteration->condition;
-        const Expression* update = for_iteration->update;
-        const BlockStatement* body = for_iteration->body;
+            validateBlockStatement(stack, while_iteration->body);
 
-        if (initial != nullptr) {
-            validateStatement(stack, initial);
+            stack.popStack();
+            break;
         }
+        case ASTType::ForIteration: {
+            const ForIteration* for_iteration = (const ForIteration*) statement;
 
-        if (condition != nullptr && !isBooleanType(getTypeOfExpression(stack, (Expression*) condition))) {
-            error("for loop condition must evaluate to a bool", nullptr);
-        }
+            const VariableDeclarationStatement* initial = for_iteration->initial;
+            const Expression* condition = for_iteration->condition;
+            const Expression* update = for_iteration->update;
+            const BlockStatement* body = for_iteration->body;
 
-        if (update != nullptr) {
-            getTypeOfExpression(stack, (Expression*) update);
-        }
+            if (initial != nullptr) {
+                validateStatement(stack, initial);
+            }
 
-        validateBlockStatement(stack, body);
-    }
-    else if (const ConditionalStatement* conditional = get_node_if(statement, ConditionalStatement)) {
-        validateConditionalStatement(stack, conditional);
-    }
-    else if (const ReturnStatement* return_statement = get_node_if(statement, ReturnStatement)) {
-        // get function return type 
-        const Function* function = getParentFunctionFromStack(stack);
+            if (condition != nullptr && !isBooleanType(getTypeOfExpression(stack, (Expression*) condition))) {
+                error("for loop condition must evaluate to a bool", nullptr);
+            }
 
-        if (function == nullptr) {
-            error("could not determine function return type", nullptr);
-        }
+            if (update != nullptr) {
+                getTypeOfExpression(stack, (Expression*) update);
+            }
 
-        if (return_statement->expression == nullptr && function->return_type == nullptr) {
-            return;
+            validateBlockStatement(stack, body);
+            break;
         }
+        case ASTType::ConditionalStatement: {
+            const ConditionalStatement* conditional = (const ConditionalStatement*) statement;
 
-        if (return_statement->expression == nullptr && function->return_type != nullptr) {
-            error("expected a return value", nullptr);
+            validateConditionalStatement(stack, conditional);
+            break;
         }
+        case ASTType::ReturnStatement: {
+            const ReturnStatement* return_statement = (const ReturnStatement*) statement;
 
-        if (return_statement->expression != nullptr && function->return_type == nullptr) {
-            error("given a return value when the function should not return anything", nullptr);
-        }
+            // get function return type 
+            const Function* function = getParentFunctionFromStack(stack);
+
+            if (function == nullptr) {
+                error("could not determine function return type", nullptr);
+            }
 
-        const DataType* return_value_type = getTypeOfExpression(stack, return_statement->expression);
+            if (return_statement->expression == nullptr && function->return_type == nullptr) {
+                return;
+            }
 
-        if (!isSameType(return_value_type, function->return_type)) {
-            error("mismatch in return type", nullptr);
-        }
-    }
-    else if (node_is(statement, ContinueStatement)) {
-        if (!withinLoop(stack)) {
-            error("`continue` statement must be within a loop", nullptr);
-        }
-    }
-    else if (node_is(statement, BreakStatement)) {
-        if (!withinLoop(stack)) {
-            error("`break` statement must be within a loop", nullptr);
+            if (return_statement->expression == nullptr && function->return_type != nullptr) {
+                error("expected a return value", nullptr);
+            }
+
+            if (return_statement->expression != nullptr && function->return_type == nullptr) {
+                error("given a return value when the function should not return anything", nullptr);
+            }
+
+            const DataType* return_value_type = getTypeOfExpression(stack, return_statement->expression);
+
+            if (!isSameType(return_value_type, types.get(function->return_type))) {
+                error("mismatch in return type", nullptr);
+            }
+            break;
         }
+        case ASTType::ContinueStatement:
+            if (!withinLoop(stack)) {
+                error("`continue` statement must be within a loop", nullptr);
+            }
+            break;
+        case ASTType::BreakStatement:
+            if (!withinLoop(stack)) {
+                error("`break` statement must be within a loop", nullptr);
+            }
+            break;
+        default:
+            break;
     }
 }
 
-DataType* Analyzer::getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryExpression* expression) {
+const DataType* Analyzer::getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryExpression* expression) {
     const OperatorToken* operation = expression->operation;
     const Expression* operand = expression->operand;
 
@@ -329,36 +557,36 @@ DataType* Analyzer::getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryE
         case TokenType::OP_INCREMENT:
         case TokenType::OP_DECREMENT: {
             if (const IdentifierConstant* identifier = get_node_if(operand, IdentifierConstant)) {
-                if (const DataType* type = symbols.lookupSymbol(identifier->value->lexeme); isIntegerType(type) && type->dimensions == 0) {
-                    return copyDataType(getTypeOfExpression(symbols, (Expression*) identifier));
+                if (const DataType* type = symbols.lookupSymbol(identifier->value->symbol); isIntegerType(type) && type->dimensions == 0) {
+                    return getTypeOfExpression(symbols, (Expression*) identifier);
                 }
             }
-            return error("invalid operand for prefix `" + operation->lexeme + "`", operation);
+            return error("invalid operand for prefix `" + std::string(operation->lexeme) + "`", operation);
         }
         case TokenType::BOOLEAN_OP_NOT: {
             const DataType* operand_type = getTypeOfExpression(symbols, (Expression*) operand);
 
-            if (operand_type != nullptr && operand_type->type_name->lexeme == "bool" && operand_type->dimensions == 0) {
-                return copyDataType(operand_type);
+            if (operand_type != nullptr && operand_type->type_name->type == TokenType::TYPE_BOOL && operand_type->dimensions == 0) {
+                return operand_type;
             }
 
-            return error("invalid operand for prefix `" + operation->lexeme + "`", operation);
+            return error("invalid operand for prefix `" + std::string(operation->lexeme) + "`", operation);
         }
         case TokenType::BITWISE_OP_COMPLEMENT: {
             const DataType* operand_type = getTypeOfExpression(symbols, (Expression*) operand);
 
             if (isIntegerType(operand_type) && operand_type->dimensions == 0) {
-                return copyDataType(operand_type);
+                return operand_type;
             }
 
-            return error("invalid operand for prefix `" + operation->lexeme + "`", operation);
+            return error("invalid operand for prefix `" + std::string(operation->lexeme) + "`", operation);
         }
         case TokenType::ARITHMETIC_OP_SUB: {
             if (const NumberConstant* number = get_node_if(operand, NumberConstant)) {
-                return copyDataType(getTypeOfExpression(symbols, (Expression*) number));
+                return getTypeOfExpression(symbols, (Expression*) number);
             }
 
-            return error("invalid operand for prefix `" + operation->lexeme + "`", operation);
+            return error("invalid operand for prefix `" + std::string(operation->lexeme) + "`", operation);
         }
         case TokenType::BITWISE_OP_AND: {
             // operand must be a variable or member access
@@ -376,28 +604,23 @@ DataType* Analyzer::getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryE
                 return error("cannot get the reference", operation);
             }
 
-            DataType* with_ref = copyDataType(operand_type);
-            with_ref->is_reference = true;
-
-            return with_ref;
-
-
+            return types.get(operand_type->type_name, true, operand_type->dimensions);
         }
         default: return nullptr;
     }
 }
 
-DataType* Analyzer::getTypeOfPostfixExpression(SymbolStack& symbols, PostfixUnaryExpression* expression) {
+const DataType* Analyzer::getTypeOfPostfixExpression(SymbolStack& symbols, PostfixUnaryExpression* expression) {
     if (const IdentifierConstant* identifier = get_node_if(expression->operand, IdentifierConstant)) {
-        if (const DataType* type = symbols.lookupSymbol(identifier->value->lexeme); isIntegerType(type) && type->dimensions == 0) {
-            return copyDataType(getTypeOfExpression(symbols, (Expression*) identifier));
+        if (const DataType* type = symbols.lookupSymbol(identifier->value->symbol); isIntegerType(type) && type->dimensions == 0) {
+            return getTypeOfExpression(symbols, (Expression*) identifier);
         }
     }
 
-    return error("invalid operand for postfix `" + expression->operation->lexeme + "`", expression->operation);
+    return error("invalid operand for postfix `" + std::string(expression->operation->lexeme) + "`", expression->operation);
 }
 
-DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpression* expression) {
+const DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpression* expression) {
     const OperatorToken* operation = expression->operation;
     const Expression* left_operand = expression->left_operand;
     const Expression* right_operand = expression->right_operand;
@@ -408,21 +631,33 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
         return nullptr;
     }
 
-    switch (operation->type) {
+    std::string complaint;
+    const DataType* type = getTypeOfBinaryOperation(operation->type, operation->lexeme, left_operand->type(), left_type, right_type, complaint);
+
+    return complaint.empty() ? type : error(complaint, operation);
+}
+
+const DataType* Analyzer::getTypeOfBinaryOperation(const TokenType operation, const std::string_view lexeme, const ASTType left_kind, const DataType* left_type, const DataType* right_type, std::string& complaint) {
+    const auto complain = [&complaint](const std::string& message) {
+        complaint = message;
+        return nullptr;
+    };
+
+    switch (operation) {
         case TokenType::ARITHMETIC_OP_ADD:
         case TokenType::ARITHMETIC_OP_SUB:
         case TokenType::ARITHMETIC_OP_MUL:
         case TokenType::ARITHMETIC_OP_DIV: {
             if (isIntegerType(left_type) && isIntegerType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             } else if (isIntegerType(left_type) && isFloatingPointType(right_type)) {
-                return copyDataType(right_type);
+                return right_type;
             } else if (isFloatingPointType(left_type) && isIntegerType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             } else if (isFloatingPointType(left_type) && isFloatingPointType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             } else {
-                return error("no support for `" + operation->lexeme + "` operation between `" + left_type->type_name->lexeme + "` and `" + right_type->type_name->lexeme + "`", operation);
+                return complain("no support for `" + std::string(lexeme) + "` operation between `" + std::string(left_type->type_name->lexeme) + "` and `" + std::string(right_type->type_name->lexeme) + "`");
             }
         }
         case TokenType::ARITHMETIC_OP_MOD:
@@ -432,16 +667,16 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
         case TokenType::BITWISE_OP_LEFT_SHIFT:
         case TokenType::BITWISE_OP_RIGHT_SHIFT: {
             if (isIntegerType(left_type) && isIntegerType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             }
             
             // both operands must be int types
-            return error("no support for `" + operation->lexeme + "` operation between `" + left_type->type_name->lexeme + "` and `" + right_type->type_name->lexeme + "`", operation);
+            return complain("no support for `" + std::string(lexeme) + "` operation between `" + std::string(left_type->type_name->lexeme) + "` and `" + std::string(right_type->type_name->lexeme) + "`");
         }
         case TokenType::RELATIONAL_OP_EQUALITY:
         case TokenType::RELATIONAL_OP_INEQUALITY: {
             if (isBooleanType(left_type) && isBooleanType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             }
 
             if (
@@ -451,26 +686,10 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
                 || (isFloatingPointType(left_type) && isFloatingPointType(right_type))
             ) {
                 
-                DataType* type = new DataType;
-
-                type->dimensions = 0;
-                type->is_reference = false;
-                
-                Token* bool_type = new Token;
-
-                bool_type->lexeme = "bool";
-                bool_type->column = operation->column;
-                bool_type->line = operation->line;
-                bool_type->index = operation->index;
-                bool_type->type = TokenType::TYPE_BOOL;
-
-                type->type_name = bool_type;
-
-                return type;
-
+                return bool_type;
             }
 
-            return error("no support for `" + operation->lexeme + "` operation between `" + left_type->type_name->lexeme + "` and `" + right_type->type_name->lexeme + "`", operation);
+            return complain("no support for `" + std::string(lexeme) + "` operation between `" + std::string(left_type->type_name->lexeme) + "` and `" + std::string(right_type->type_name->lexeme) + "`");
         }
 
         case TokenType::RELATIONAL_OP_LESS_THAN:
@@ -483,49 +702,34 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
                 || (isFloatingPointType(left_type) && isIntegerType(right_type))
                 || (isFloatingPointType(left_type) && isFloatingPointType(right_type))
             ) {
-                DataType* type = new DataType;
-
-                type->dimensions = 0;
-                type->is_reference = false;
-                
-                Token* bool_type = new Token;
-
-                bool_type->lexeme = "bool";
-                bool_type->column = operation->column;
-                bool_type->line = operation->line;
-                bool_type->index = operation->index;
-                bool_type->type = TokenType::TYPE_BOOL;
-
-                type->type_name = bool_type;
-
-                return type;
+                return bool_type;
             }
 
-            return error("no support for `" + operation->lexeme + "` operation between `" + left_type->type_name->lexeme + "` and `" + right_type->type_name->lexeme + "`", operation);
+            return complain("no support for `" + std::string(lexeme) + "` operation between `" + std::string(left_type->type_name->lexeme) + "` and `" + std::string(right_type->type_name->lexeme) + "`");
         }
 
         case TokenType::BOOLEAN_OP_AND:
         case TokenType::BOOLEAN_OP_OR:
         case TokenType::BOOLEAN_OP_XOR: {
             if (isBooleanType(left_type) && isBooleanType(right_type)) {
-                return copyDataType(left_type);
+                return left_type;
             }
 
-            return error("no support for `" + operation->lexeme + "` operation between `" + left_type->type_name->lexeme + "` and `" + right_type->type_name->lexeme + "`", operation);
+            return complain("no support for `" + std::string(lexeme) + "` operation between `" + std::string(left_type->type_name->lexeme) + "` and `" + std::string(right_type->type_name->lexeme) + "`");
         }
         case TokenType::ASSIGNMENT_ASSIGN: {
             // left must be a variable
             // right must be the same type
-            if (left_operand->type() != ASTType::IdentifierConstant && left_operand->type() != ASTType::MemberAccess) {
-                return error("left operand must be assignable", operation);
+            if (left_kind != ASTType::IdentifierConstant && left_kind != ASTType::MemberAccess) {
+                return complain("left operand must be assignable");
             }
 
             if (!isSameType(left_type, right_type)) {
-                return error("could not assign `" + left_type->type_name->lexeme + "` to `" + right_type->type_name->lexeme + "`", operation);
+                return complain("could not assign `" + std::string(left_type->type_name->lexeme) + "` to `" + std::string(right_type->type_name->lexeme) + "`");
             }
 
 
-            return copyDataType(left_type);
+            return left_type;
         }
         case TokenType::ASSIGNMENT_OP_ADD:
         case TokenType::ASSIGNMENT_OP_SUB:
@@ -533,19 +737,19 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
         case TokenType::ASSIGNMENT_OP_DIV: {
             // left must a variable of type int or float
             // right must be a int or float type
-            if (left_operand->type() != ASTType::IdentifierConstant && left_operand->type() != ASTType::MemberAccess) {
-                return error("left operand must be assignable", operation);
+            if (left_kind != ASTType::IdentifierConstant && left_kind != ASTType::MemberAccess) {
+                return complain("left operand must be assignable");
             }
 
             if (!isIntegerType(left_type) && !isFloatingPointType(left_type)) {
-                return error("left operand must be either an integer type or floating point type", operation);
+                return complain("left operand must be either an integer type or floating point type");
             }
 
             if (!isIntegerType(right_type) && !isFloatingPointType(right_type)) {
-                return error("right operand must be either an integer type or floating point type", operation);
+                return complain("right operand must be either an integer type or floating point type");
             }
 
-            return copyDataType(left_type);
+            return left_type;
         }
         case TokenType::ASSIGNMENT_OP_MOD:
         case TokenType::ASSIGNMENT_OP_AND:
@@ -555,188 +759,128 @@ DataType* Analyzer::getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpres
         case TokenType::ASSIGNMENT_OP_RIGHT_SHIFT: {
             // left must be a variable with int type
             // right must be a int type
-            if (left_operand->type() != ASTType::IdentifierConstant && left_operand->type() != ASTType::MemberAccess) {
-                return error("left operand must be assignable", operation);
+            if (left_kind != ASTType::IdentifierConstant && left_kind != ASTType::MemberAccess) {
+                return complain("left operand must be assignable");
             }
 
             if (!isIntegerType(left_type)) {
-                return error("left operand must be an integer type", operation);
+                return complain("left operand must be an integer type");
             }
 
             if (!isIntegerType(right_type)) {
-                return error("right operand must be either an integer type", operation);
+                return complain("right operand must be either an integer type");
             }
 
-            return copyDataType(left_type);
+            return left_type;
         }
 
         default: return nullptr;
     }
 }
 
-DataType* Analyzer::getTypeOfNumberExpression(NumberConstant* number) {
+const DataType* Analyzer::getTypeOfNumberExpression(NumberConstant* number) {
     switch (number->value->type) {
         case TokenType::INTEGER_LITERAL: {
-            DataType* type = new DataType;
-
-            type->dimensions = 0;
-            type->is_reference = false;
-            
-            Token* number_type = new Token;
-
-            number_type->lexeme = "int";
-            number_type->column = number->value->column;
-            number_type->line = number->value->line;
-            number_type->index = number->value->index;
-            number_type->type = TokenType::TYPE_INT;
-
-            type->type_name = number_type;
-
-            return type;
+            return int_type;
         }
         case TokenType::FLOAT_LITERAL: {
-            DataType* type = new DataType;
-
-            type->dimensions = 0;
-            type->is_reference = false;
-            
-            Token* number_type = new Token;
-
-            number_type->lexeme = "float";
-            number_type->column = number->value->column;
-            number_type->line = number->value->line;
-            number_type->index = number->value->index;
-            number_type->type = TokenType::TYPE_FLOAT;
-
-            type->type_name = number_type;
-
-            return type;
+            return float_type;
         }
         default: return nullptr;
     }
 }
 
-DataType* Analyzer::getTypeOfIdentifier(SymbolStack& symbols, IdentifierConstant* identifier) {
-    if (const DataType* type = symbols.lookupSymbol(identifier->value->lexeme)) {
-        return copyDataType(type);
+const DataType* Analyzer::getTypeOfIdentifier(SymbolStack& symbols, IdentifierConstant* identifier) {
+    if (const DataType* type = symbols.lookupSymbol(identifier->value->symbol)) {
+        return type;
     }
 
-    return error("`" + identifier->value->lexeme + "` is undefined", identifier->value);
+    return error("`" + std::string(identifier->value->lexeme) + "` is undefined", identifier->value);
 }
 
-DataType* Analyzer::getTypeOfLiteral(LiteralExpression* literal) {
+const DataType* Analyzer::getTypeOfLiteral(LiteralExpression* literal) {
     switch (literal->value->type) {
         case TokenType::LITERAL_BOOLEAN_TRUE:
         case TokenType::LITERAL_BOOLEAN_FALSE: {
-            DataType* type = new DataType;
-
-            type->dimensions = 0;
-            type->is_reference = false;
-            
-            Token* bool_type = new Token;
-
-            bool_type->lexeme = "bool";
-            bool_type->column = literal->value->column;
-            bool_type->line = literal->value->line;
-            bool_type->index = literal->value->index;
-            bool_type->type = TokenType::TYPE_BOOL;
-
-            type->type_name = bool_type;
-
-            return type;
+            return bool_type;
         }
         case TokenType::LITERAL_REFERENCE_NULL: {
-            DataType* type = new DataType;
-
-            type->dimensions = 0;
-            type->is_reference = true;
-            
-            Token* reference_type = new Token;
-
-            reference_type->lexeme = "null";
-            reference_type->column = literal->value->column;
-            reference_type->line = literal->value->line;
-            reference_type->index = literal->value->index;
-            reference_type->type = TokenType::LITERAL_REFERENCE_NULL;
-
-            type->type_name = reference_type;
-
-            return type;
+            return null_type;
         }
 
         default: return nullptr;
     }
 }
 
-DataType* Analyzer::getTypeOfMemberAccess(SymbolStack& symbols, MemberAccess* member_access) {
+const DataType* Analyzer::getTypeOfMemberAccess(SymbolStack& symbols, MemberAccess* member_access) {
     const Expression* owner = member_access->owner;
     const IdentifierToken* member = member_access->member;
 
     const DataType* owner_type = getTypeOfExpression(symbols, (Expression*) owner);
 
     if (owner_type == nullptr) {
-        return error("could not determine what `" + member->lexeme + "` is", member);
+        return error("could not determine what `" + std::string(member->lexeme) + "` is", member);
     }
 
-    const Structure* structure = symbol_table->lookupStructure(owner_type->type_name->lexeme);
-    const StructureMembers* members = structure->members;
+    const Structure* structure = symbol_table->lookupStructure(owner_type->type_name->symbol);
+    const StructureMembers* members = structure != nullptr ? structure->members : nullptr;
     if (members == nullptr) {
-        return error("member `" + member->lexeme + "` does not exist", member);
+        return error("member `" + std::string(member->lexeme) + "` does not exist", member);
     }
 
     for (const VariableDeclarator* variable_declarator : members->members) {
-        if (variable_declarator->variable_name->lexeme == member->lexeme) {
-            return copyDataType(variable_declarator->data_type);
+        if (variable_declarator->variable_name->symbol == member->symbol) {
+            return types.get(variable_declarator->data_type);
         }
     }
 
-    return error("struct `" + structure->name->lexeme + "` does not have a member `" + member->lexeme + "`", member);
+    return error("struct `" + std::string(structure->name->lexeme) + "` does not have a member `" + std::string(member->lexeme) + "`", member);
 }
 
-DataType* Analyzer::getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* function_call) {
+const DataType* Analyzer::getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* function_call) {
     if (const IdentifierConstant* identifier = get_node_if(function_call->function, IdentifierConstant)) {
-        const Function* function = symbol_table->lookupFunction(identifier->value->lexeme);
+        const Function* function = symbol_table->lookupFunction(identifier->value->symbol);
 
         if (function == nullptr) {
-            return error("`" + identifier->value->lexeme + "()` is undefined", identifier->value);
+            return error("`" + std::string(identifier->value->lexeme) + "()` is undefined", identifier->value);
         }
 
         if (function->owner != nullptr) {
-            return error("`" + function->owner->lexeme + "::" + function->name->lexeme + "()` cannot be called here", identifier->value);
+            return error("`" + std::string(function->owner->lexeme) + "::" + std::string(function->name->lexeme) + "()` cannot be called here", identifier->value);
         }
 
         const uint32_t args_count = function_call->arguments == nullptr ? 0 : function_call->arguments->expressions.size();
         const uint32_t require_args = function->parameters == nullptr ? 0 : function->parameters->parameters.size();
 
         if (args_count != require_args) {
-            return error("`" + function->name->lexeme + "()` requires " + std::to_string(require_args) + " arguments but were given " + std::to_string(args_count), identifier->value);
+            return error("`" + std::string(function->name->lexeme) + "()` requires " + std::to_string(require_args) + " arguments but were given " + std::to_string(args_count), identifier->value);
         }
 
         for (uint32_t i = 0; i < args_count; ++i) {
             const DataType* given_type = getTypeOfExpression(symbols, function_call->arguments->expressions.at(i));
             const DataType* require_type = function->parameters->parameters.at(i)->data_type;
 
-            if (!isSameType(given_type, require_type)) {
+            if (!isSameType(given_type, types.get(require_type))) {
                 return error("invalid arguments", identifier->value);
             }
         }
         
-        return copyDataType(function->return_type);
+        return types.get(function->return_type);
     }
     else if (const MemberAccess* member_access = get_node_if(function_call->function, MemberAccess)) {
         const Expression* operand = member_access->owner;
         const IdentifierToken* member_function = member_access->member;
 
         const DataType* operand_type = getTypeOfExpression(symbols, (Expression*) operand);
-        const Function* function = symbol_table->lookupFunction(member_function->lexeme);
+        const Function* function = symbol_table->lookupFunction(member_function->symbol);
 
         if (operand_type == nullptr) {
             return error("could not determine where this member function comes from", member_function);
         }
 
         // function does not exist or function has no owner or the owner has no member function of this name
-        if (function == nullptr || function->owner == nullptr || operand_type->type_name->lexeme != function->owner->lexeme) {
-            return error("`" + operand_type->type_name->lexeme + "` does not have a member function `" + member_function->lexeme + "()`", member_function);
+        if (function == nullptr || function->owner == nullptr || operand_type->type_name->symbol != function->owner->symbol) {
+            return error("`" + std::string(operand_type->type_name->lexeme) + "` does not have a member function `" + std::string(member_function->lexeme) + "()`", member_function);
         }
 
         if (operand_type->dimensions != 0) {
@@ -747,19 +891,19 @@ DataType* Analyzer::getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* fu
         const uint32_t require_args = function->parameters == nullptr ? 0 : function->parameters->parameters.size();
 
         if (args_count != require_args) {
-            return error("`" + function->name->lexeme + "()` requires " + std::to_string(require_args) + " arguments but were given " + std::to_string(args_count), member_function);
+            return error("`" + std::string(function->name->lexeme) + "()` requires " + std::to_string(require_args) + " arguments but were given " + std::to_string(args_count), member_function);
         }
 
         for (uint32_t i = 0; i < args_count; ++i) {
             const DataType* given_type = getTypeOfExpression(symbols, function_call->arguments->expressions.at(i));
             const DataType* require_type = function->parameters->parameters.at(i)->data_type;
 
-            if (!isSameType(given_type, require_type)) {
+            if (!isSameType(given_type, types.get(require_type))) {
                 return error("invalid arguments", member_function);
             }
         }
         
-        return copyDataType(function->return_type);
+        return types.get(function->return_type);
     }
     // else if (const ArrayAccess* array_access = get_node_if(function_call->function, ArrayAccess)) {
     //     return error("array access", nullptr);
@@ -769,29 +913,6 @@ DataType* Analyzer::getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* fu
     }
 }
 
-DataType* Analyzer::copyDataType(const DataType* type) {
-    if (type == nullptr) {
-        return nullptr;
-    }
-
-    DataType* copy = new DataType;
-
-    copy->dimensions = type->dimensions;
-    copy->is_reference = type->is_reference;
-
-    Token* type_name = new Token;
-
-    type_name->lexeme = type->type_name->lexeme;
-    type_name->column = type->type_name->column;
-    type_name->line = type->type_name->line;
-    type_name->index = type->type_name->index;
-    type_name->type = type->type_name->type;
-
-    copy->type_name = type_name;
-
-    return copy;
-}
-
 void Analyzer::validateConditionalStatement(SymbolStack& symbols, const ConditionalStatement* conditional) {
     if (conditional == nullptr) {
         return;
@@ -822,7 +943,7 @@ std::nullptr_t Analyzer::error(const std::string& message, const Token* token) {
     has_error = true;
 
     if (token == nullptr) {
-        std::cerr << message << std::endl;
+        reports.append(message + '\n');
         return nullptr;
     }
 
@@ -841,15 +962,15 @@ std::nullptr_t Analyzer::error(const std::string& message, const Token* token) {
         const std::string line_number = std::to_string(token->line + 1);
         const std::string divider = std::string(line_number.size() + 2, ' ') + ':';
 
-        const std::string line_preview = module->source->content.at(token->line); 
-        const std::string line_content = " " + line_number + " | " + line_preview;
+        const std::string_view line_preview = module->source->lineAt(token->line);
+        const std::string line_content = " " + line_number + " | " + std::string(line_preview);
         const std::string underline = std::string(min_of(token->lexeme.size(), line_preview.size() - token->column), '^');
         const std::string footer = divider + std::string(token->column + 1, ' ') + underline;
 
         preview = divider + '\n' + line_content + footer;
     }
 
-    std::cerr << header << info << preview << std::endl;
+    reports.append(header + info + preview + '\n');
 
     return nullptr;
 }
@@ -882,26 +1003,17 @@ bool Analyzer::isBooleanType(const DataType* type) {
 }
 
 bool Analyzer::isSameType(const DataType* type_1, const DataType* type_2) {
-    if (type_1 == nullptr && type_2 == nullptr) {
+    // Both come from the type table, where equal types are one type
+    if (type_1 == type_2) {
         return true;
     }
 
-    if (type_1 == nullptr || type_2 == nullptr) {
-        return false;
-    }
-
-    if (type_1->is_reference && type_2->type_name->type == TokenType::LITERAL_REFERENCE_NULL) {
-        return true;
-    }
-
-    return type_1->dimensions == type_2->dimensions 
-        && type_1->is_reference == type_2->is_reference
-        && type_1->type_name->lexeme == type_2->type_name->lexeme;
+    return type_1 != nullptr && type_1->is_reference && type_2 == null_type;
 }
 
 bool Analyzer::withinLoop(SymbolStack& stack) {
-    for (const std::pair<const AST*, std::unordered_map<std::string, const DataType*>>& data : stack.stack) {
-        const AST* parent = data.first;
+    for (const SymbolStack::Scope& scope : stack.scopes) {
+        const AST* parent = scope.parent;
 
         if (node_is(parent, WhileIteration) || node_is(parent, ForIteration)) {
             return true;
@@ -912,8 +1024,8 @@ bool Analyzer::withinLoop(SymbolStack& stack) {
 }
 
 const Function* Analyzer::getParentFunctionFromStack(SymbolStack& stack) {
-    for (const std::pair<const AST*, std::unordered_map<std::string, const DataType*>>& data : stack.stack) {
-        const AST* parent = data.first;
+    for (const SymbolStack::Scope& scope : stack.scopes) {
+        const AST* parent = scope.parent;
 
         if (node_is(parent, Function)) {
             return (const Function*) parent;
@@ -930,31 +1042,553 @@ void Analyzer::pushParametersToStack(SymbolStack& stack, const Function* functio
 
     if (function->parameters != nullptr) {
         for (const VariableDeclarator* variables : function->parameters->parameters) {
-            stack.addSymbol(variables->variable_name->lexeme, variables->data_type);
+            stack.addSymbol(variables->variable_name->symbol, types.get(variables->data_type));
         }
     }
 
     if (function->owner != nullptr) {
-        DataType* type = new DataType;
+        stack.addSymbol(self_symbol, types.get(function->owner, true, 0));
+    }
+}
 
-        type->dimensions = 0;
-        type->is_reference = true;
-        
-        Token* ref_type = new Token;
+// <*> ========================= FLAT TREE ========================= <*>
+
+// The walk of a flat tree below makes the same checks in the same order as
+// the walk of a pointer tree above, so both report the same errors
+
+uint32_t Analyzer::functionCount(void) const {
+    return flat != nullptr ? flat_table->getAllFunctions().size() : symbol_table->getAllFunctions().size();
+}
+
+void Analyzer::loadFlatSymbols(void) {
+    const TokenStream& tokens = *module->tokens;
 
-        ref_type->lexeme = function->owner->lexeme;
-        ref_type->column = function->owner->column;
-        ref_type->line = function->owner->line;
-        ref_type->index = function->owner->index;
-        ref_type->type = function->owner->type;
+    for (const FlatDeclaration& declaration : flat->declarations) {
+        if (declaration.kind == ASTType::Function) {
+            const uint32_t name = flat->functions[declaration.node].name;
 
-        type->type_name = ref_type;
+            if (!flat_table->loadFunction(tokens.symbol(name), declaration.node)) {
+                errorAt("function `" + std::string(tokens.lexeme(name)) + "` is already defined", name);
+            }
+        } else if (declaration.kind == ASTType::Structure) {
+            const uint32_t name = flat->structures[declaration.node].name;
 
-        stack.addSymbol("self", type);
+            if (!flat_table->loadStructure(tokens.symbol(name), declaration.node)) {
+                errorAt("struct `" + std::string(tokens.lexeme(name)) + "` already defined", name);
+            }
+        }
+    }
+}
+
+void Analyzer::validateFlatStructures(void) {
+    for (const NodeIndex structure : flat_table->getAllStructures()) {
+        validateFlatStructureMember(structure);
+    }
+}
+
+void Analyzer::validateFlatStructureMember(const NodeIndex structure) {
+    const TokenStream& tokens = *module->tokens;
+    const uint32_t structure_name = flat->structures[structure].name;
+
+    std::unordered_set<SymbolId> member_table;
+
+    for (const NodeIndex member : flat->childrenOf(flat->structures[structure].members)) {
+        const FlatType& member_type = flat->types[flat->declarators[member].data_type];
+        const uint32_t member_identifier = flat->declarators[member].variable_name;
+
+        if (tokens.type(member_type.type_name) == TokenType::IDENTIFIER) {
+            const NodeIndex symbol = flat_table->lookupStructure(tokens.symbol(member_type.type_name));
+
+            if (symbol == NO_NODE) {
+                errorAt("type `" + std::string(tokens.lexeme(member_type.type_name)) + "` is undefined", member_type.type_name);
+            } else {
+                const bool contains_self = symbol == structure;
+                const bool has_non_direct_reference = member_type.is_reference || member_type.dimensions > 0;
+
+                if (contains_self && !has_non_direct_reference) {
+                    errorAt("struct `" + std::string(tokens.lexeme(structure_name)) + "` contains a self referencing member", member_identifier);
+                }
+            }
+        }
+
+        if (!member_table.insert(tokens.symbol(member_identifier)).second) {
+            errorAt("struct `" + std::string(tokens.lexeme(structure_name)) + "` has multiple members of `" + std::string(tokens.lexeme(member_identifier)) + "`", member_identifier);
+        }
     }
 }
 
+void Analyzer::validateFlatFunction(const NodeIndex index) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatFunction& function = flat->functions[index];
+
+    if (function.owner != NO_TOKEN && flat_table->lookupStructure(tokens.symbol(function.owner)) == NO_NODE) {
+        errorAt("struct `" + std::string(tokens.lexeme(function.owner)) + "` is undefined", function.owner);
+    }
+
+    if (function.return_type != NO_NODE) {
+        const uint32_t type_name = flat->types[function.return_type].type_name;
+
+        if (tokens.type(type_name) == TokenType::IDENTIFIER && flat_table->lookupStructure(tokens.symbol(type_name)) == NO_NODE) {
+            errorAt("struct `" + std::string(tokens.lexeme(type_name)) + "` is undefined", type_name);
+        }
+    }
+
+    validateFlatFunctionParameters(function);
+    validateFlatFunctionBody(index);
+}
+
+void Analyzer::validateFlatFunctionParameters(const FlatFunction& function) {
+    const TokenStream& tokens = *module->tokens;
+
+    if (function.parameters == NO_NODE) {
+        return;
+    }
+
+    std::unordered_set<SymbolId> parameter_table;
+
+    if (function.owner != NO_TOKEN) {
+        parameter_table.insert(self_symbol);
+    }
+
+    for (const NodeIndex parameter : flat->childrenOf(function.parameters)) {
+        const uint32_t type_name = flat->types[flat->declarators[parameter].data_type].type_name;
+        const uint32_t parameter_identifier = flat->declarators[parameter].variable_name;
+
+        if (tokens.type(type_name) == TokenType::IDENTIFIER && flat_table->lookupStructure(tokens.symbol(type_name)) == NO_NODE) {
+            errorAt("type `" + std::string(tokens.lexeme(type_name)) + " is undefined", type_name);
+        }
+
+        if (!parameter_table.insert(tokens.symbol(parameter_identifier)).second) {
+            errorAt("multiple parameter name of `" + std::string(tokens.lexeme(parameter_identifier)) + "`", parameter_identifier);
+        }
+    }
+}
+
+void Analyzer::validateFlatFunctionBody(const NodeIndex index) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatFunction& function = flat->functions[index];
+
+    current_function = index;
+    loop_depth = 0;
+
+    symbol_stack.pushStack(nullptr);
+
+    if (function.parameters != NO_NODE) {
+        for (const NodeIndex parameter : flat->childrenOf(function.parameters)) {
+            symbol_stack.addSymbol(tokens.symbol(flat->declarators[parameter].variable_name), getFlatType(flat->declarators[parameter].data_type));
+        }
+    }
+
+    if (function.owner != NO_TOKEN) {
+        symbol_stack.addSymbol(self_symbol, types.get(tokens.symbol(function.owner), tokens.type(function.owner), tokens.lexeme(function.owner), true, 0));
+    }
+
+    validateFlatBlockStatement(symbol_stack, function.body);
+
+    symbol_stack.popStack();
+}
+
+const DataType* Analyzer::getFlatType(const NodeIndex type) {
+    if (type == NO_NODE) {
+        return nullptr;
+    }
+
+    const TokenStream& tokens = *module->tokens;
+    const FlatType& flat_type = flat->types[type];
+
+    return types.get(tokens.symbol(flat_type.type_name), tokens.type(flat_type.type_name), tokens.lexeme(flat_type.type_name), flat_type.is_reference, flat_type.dimensions);
+}
+
+const DataType* Analyzer::getTypeOfFlatExpression(SymbolStack& symbols, const NodeIndex index) {
+    if (index == NO_NODE) {
+        return nullptr;
+    }
+
+    // Written in place, the array is not resized while the tree is walked
+    const DataType*& evaluated_type = flat->evaluated_types[index];
+
+    if (evaluated_type != nullptr) {
+        return evaluated_type;
+    }
+
+    const TokenStream& tokens = *module->tokens;
+    const FlatExpression& expression = flat->expressions[index];
+
+    switch (expression.kind) {
+        case ASTType::PrefixUnaryExpression:
+            evaluated_type = getTypeOfFlatPrefixExpression(symbols, expression);
+            break;
+        case ASTType::PostfixUnaryExpression:
+            evaluated_type = getTypeOfFlatPostfixExpression(symbols, expression);
+            break;
+        case ASTType::BinaryExpression:
+            evaluated_type = getTypeOfFlatBinaryExpression(symbols, expression);
+            break;
+        case ASTType::NumberConstant:
+            switch (tokens.type(expression.token)) {
+                case TokenType::INTEGER_LITERAL: evaluated_type = int_type; break;
+                case TokenType::FLOAT_LITERAL: evaluated_type = float_type; break;
+                default: break;
+            }
+            break;
+        case ASTType::IdentifierConstant:
+            if ((evaluated_type = symbols.lookupSymbol(tokens.symbol(expression.token))) == nullptr) {
+                errorAt("`" + std::string(tokens.lexeme(expression.token)) + "` is undefined", expression.token);
+            }
+            break;
+        case ASTType::LiteralExpression:
+            switch (tokens.type(expression.token)) {
+                case TokenType::LITERAL_BOOLEAN_TRUE:
+                case TokenType::LITERAL_BOOLEAN_FALSE: evaluated_type = bool_type; break;
+                case TokenType::LITERAL_REFERENCE_NULL: evaluated_type = null_type; break;
+                default: break;
+            }
+            break;
+        case ASTType::MemberAccess:
+            evaluated_type = getTypeOfFlatMemberAccess(symbols, expression);
+            break;
+        case ASTType::FunctionCall:
+            evaluated_type = getTypeOfFlatFunctionCall(symbols, expression);
+            break;
+        default:
+            break;
+    }
+
+    return evaluated_type;
+}
+
+void Analyzer::validateFlatBlockStatement(SymbolStack& stack, const NodeIndex block) {
+    for (const NodeIndex statement : flat->childrenOf(block)) {
+        validateFlatStatement(stack, statement);
+    }
+}
+
+void Analyzer::validateFlatStatement(SymbolStack& stack, const NodeIndex index) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatStatement& statement = flat->statements[index];
+
+    switch (statement.kind) {
+        case ASTType::VariableDeclarationStatement: {
+            const FlatDeclarator& declarator = flat->declarators[statement.nested];
+            const uint32_t type_name = flat->types[declarator.data_type].type_name;
+            const uint32_t variable_name = declarator.variable_name;
+
+            if (tokens.type(type_name) == TokenType::IDENTIFIER && flat_table->lookupStructure(tokens.symbol(type_name)) == NO_NODE) {
+                errorAt("type `" + std::string(tokens.lexeme(type_name)) + "` is undefined", type_name);
+            }
+
+            if (stack.lookupSymbol(tokens.symbol(variable_name)) != nullptr) {
+                errorAt("variable name of `" + std::string(tokens.lexeme(variable_name)) + "` is already defined", variable_name);
+            } else {
+                stack.addSymbol(tokens.symbol(variable_name), getFlatType(declarator.data_type));
+            }
+
+            if (statement.expression != NO_NODE) {
+                const DataType* initial_value_type = getTypeOfFlatExpression(stack, statement.expression);
+
+                if (initial_value_type == nullptr) {
+                    errorAt("could not assign initial value", variable_name);
+                    return;
+                }
+
+                if (!isSameType(getFlatType(declarator.data_type), initial_value_type)) {
+                    errorAt("`" + std::string(tokens.lexeme(variable_name)) + "` was declared as `" + std::string(tokens.lexeme(type_name)) + "` but was initialize as `" + std::string(initial_value_type->type_name->lexeme) + "`", variable_name);
+                }
+            }
+            break;
+        }
+        case ASTType::ExpressionStatement:
+            getTypeOfFlatExpression(stack, statement.expression);
+            break;
+        case ASTType::WhileIteration: {
+            if (!isBooleanType(getTypeOfFlatExpression(stack, statement.expression))) {
+                error("while condition should evaluate to be bool", nullptr);
+            }
+
+            stack.pushStack(nullptr);
+            ++loop_depth;
+
+            validateFlatBlockStatement(stack, statement.body);
+
+            --loop_depth;
+            stack.popStack();
+            break;
+        }
+        case ASTType::ForIteration: {
+            if (statement.nested != NO_NODE) {
+                validateFlatStatement(stack, statement.nested);
+            }
+
+            if (statement.expression != NO_NODE && !isBooleanType(getTypeOfFlatExpression(stack, statement.expression))) {
+                error("for loop condition must evaluate to a bool", nullptr);
+            }
+
+            getTypeOfFlatExpression(stack, statement.update);
+
+            validateFlatBlockStatement(stack, statement.body);
+            break;
+        }
+        case ASTType::ConditionalStatement:
+            validateFlatConditionalStatement(stack, index);
+            break;
+        case ASTType::ReturnStatement: {
+            const NodeIndex return_type = flat->functions[current_function].return_type;
+
+            if (statement.expression == NO_NODE && return_type == NO_NODE) {
+                return;
+            }
+
+            if (statement.expression == NO_NODE && return_type != NO_NODE) {
+                error("expected a return value", nullptr);
+            }
+
+            if (statement.expression != NO_NODE && return_type == NO_NODE) {
+                error("given a return value when the function should not return anything", nullptr);
+            }
+
+            if (!isSameType(getTypeOfFlatExpression(stack, statement.expression), getFlatType(return_type))) {
+                error("mismatch in return type", nullptr);
+            }
+            break;
+        }
+        case ASTType::ContinueStatement:
+            if (loop_depth == 0) {
+                error("`continue` statement must be within a loop", nullptr);
+            }
+            break;
+        case ASTType::BreakStatement:
+            if (loop_depth == 0) {
+                error("`break` statement must be within a loop", nullptr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void Analyzer::validateFlatConditionalStatement(SymbolStack& symbols, const NodeIndex index) {
+    if (index == NO_NODE) {
+        return;
+    }
+
+    const FlatStatement& conditional = flat->statements[index];
+
+    if (!isBooleanType(getTypeOfFlatExpression(symbols, conditional.expression))) {
+        error("if condition should evaluate to be bool", nullptr);
+    }
+
+    symbols.pushStack(nullptr);
+
+    validateFlatBlockStatement(symbols, conditional.body);
+
+    symbols.popStack();
+
+    if (conditional.nested != NO_NODE && flat->statements[conditional.nested].kind == ASTType::BlockStatement) {
+        symbols.pushStack(nullptr);
+
+        validateFlatBlockStatement(symbols, flat->statements[conditional.nested].body);
+
+        symbols.popStack();
+    } else {
+        validateFlatConditionalStatement(symbols, conditional.nested);
+    }
+}
+
+const DataType* Analyzer::getTypeOfFlatPrefixExpression(SymbolStack& symbols, const FlatExpression& expression) {
+    const TokenStream& tokens = *module->tokens;
+    const uint32_t operation = expression.token;
+    const FlatExpression& operand = flat->expressions[expression.left];
+
+    switch (tokens.type(operation)) {
+        case TokenType::OP_INCREMENT:
+        case TokenType::OP_DECREMENT: {
+            if (operand.kind == ASTType::IdentifierConstant) {
+                if (const DataType* type = symbols.lookupSymbol(tokens.symbol(operand.token)); isIntegerType(type) && type->dimensions == 0) {
+                    return getTypeOfFlatExpression(symbols, expression.left);
+                }
+            }
+            return errorAt("invalid operand for prefix `" + std::string(tokens.lexeme(operation)) + "`", operation);
+        }
+        case TokenType::BOOLEAN_OP_NOT: {
+            const DataType* operand_type = getTypeOfFlatExpression(symbols, expression.left);
+
+            if (operand_type != nullptr && operand_type->type_name->type == TokenType::TYPE_BOOL && operand_type->dimensions == 0) {
+                return operand_type;
+            }
+
+            return errorAt("invalid operand for prefix `" + std::string(tokens.lexeme(operation)) + "`", operation);
+        }
+        case TokenType::BITWISE_OP_COMPLEMENT: {
+            const DataType* operand_type = getTypeOfFlatExpression(symbols, expression.left);
+
+            if (isIntegerType(operand_type) && operand_type->dimensions == 0) {
+                return operand_type;
+            }
+
+            return errorAt("invalid operand for prefix `" + std::string(tokens.lexeme(operation)) + "`", operation);
+        }
+        case TokenType::ARITHMETIC_OP_SUB: {
+            if (operand.kind == ASTType::NumberConstant) {
+                return getTypeOfFlatExpression(symbols, expression.left);
+            }
+
+            return errorAt("invalid operand for prefix `" + std::string(tokens.lexeme(operation)) + "`", operation);
+        }
+        case TokenType::BITWISE_OP_AND: {
+            if (operand.kind != ASTType::IdentifierConstant && operand.kind != ASTType::MemberAccess) {
+                return errorAt("cannot get the reference", operation);
+            }
+
+            const DataType* operand_type = getTypeOfFlatExpression(symbols, expression.left);
+
+            if (operand_type == nullptr) {
+                return errorAt("could not infer type", operation);
+            }
+
+            if (operand_type->is_reference || operand_type->dimensions > 0) {
+                return errorAt("cannot get the reference", operation);
+            }
+
+            return types.get(operand_type->type_name, true, operand_type->dimensions);
+        }
+        default: return nullptr;
+    }
+}
+
+const DataType* Analyzer::getTypeOfFlatPostfixExpression(SymbolStack& symbols, const FlatExpression& expression) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatExpression& operand = flat->expressions[expression.left];
+
+    if (operand.kind == ASTType::IdentifierConstant) {
+        if (const DataType* type = symbols.lookupSymbol(tokens.symbol(operand.token)); isIntegerType(type) && type->dimensions == 0) {
+            return getTypeOfFlatExpression(symbols, expression.left);
+        }
+    }
+
+    return errorAt("invalid operand for postfix `" + std::string(tokens.lexeme(expression.token)) + "`", expression.token);
+}
+
+const DataType* Analyzer::getTypeOfFlatBinaryExpression(SymbolStack& symbols, const FlatExpression& expression) {
+    const TokenStream& tokens = *module->tokens;
+    const DataType* left_type = getTypeOfFlatExpression(symbols, expression.left);
+    const DataType* right_type = getTypeOfFlatExpression(symbols, expression.right);
+
+    if (left_type == nullptr || right_type == nullptr) {
+        return nullptr;
+    }
+
+    std::string complaint;
+    const DataType* type = getTypeOfBinaryOperation(tokens.type(expression.token), tokens.lexeme(expression.token), flat->expressions[expression.left].kind, left_type, right_type, complaint);
+
+    return complaint.empty() ? type : errorAt(complaint, expression.token);
+}
+
+const DataType* Analyzer::getTypeOfFlatMemberAccess(SymbolStack& symbols, const FlatExpression& member_access) {
+    const TokenStream& tokens = *module->tokens;
+    const uint32_t member = member_access.token;
+
+    const DataType* owner_type = getTypeOfFlatExpression(symbols, member_access.left);
+
+    if (owner_type == nullptr) {
+        return errorAt("could not determine what `" + std::string(tokens.lexeme(member)) + "` is", member);
+    }
+
+    const NodeIndex structure = flat_table->lookupStructure(owner_type->type_name->symbol);
+    if (structure == NO_NODE) {
+        return errorAt("member `" + std::string(tokens.lexeme(member)) + "` does not exist", member);
+    }
+
+    for (const NodeIndex declarator : flat->childrenOf(flat->structures[structure].members)) {
+        if (tokens.symbol(flat->declarators[declarator].variable_name) == tokens.symbol(member)) {
+            return getFlatType(flat->declarators[declarator].data_type);
+        }
+    }
+
+    return errorAt("struct `" + std::string(tokens.lexeme(flat->structures[structure].name)) + "` does not have a member `" + std::string(tokens.lexeme(member)) + "`", member);
+}
+
+const DataType* Analyzer::getTypeOfFlatFunctionCall(SymbolStack& symbols, const FlatExpression& function_call) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatExpression& called = flat->expressions[function_call.left];
+
+    if (called.kind == ASTType::IdentifierConstant) {
+        const NodeIndex function = flat_table->lookupFunction(tokens.symbol(called.token));
+
+        if (function == NO_NODE) {
+            return errorAt("`" + std::string(tokens.lexeme(called.token)) + "()` is undefined", called.token);
+        }
+
+        const FlatFunction& callee = flat->functions[function];
+
+        if (callee.owner != NO_TOKEN) {
+            return errorAt("`" + std::string(tokens.lexeme(callee.owner)) + "::" + std::string(tokens.lexeme(callee.name)) + "()` cannot be called here", called.token);
+        }
+
+        return getTypeOfFlatCall(symbols, callee, function_call.right, called.token);
+    } else if (called.kind == ASTType::MemberAccess) {
+        const uint32_t member_function = called.token;
+
+        const DataType* operand_type = getTypeOfFlatExpression(symbols, called.left);
+        const NodeIndex function = flat_table->lookupFunction(tokens.symbol(member_function));
+
+        if (operand_type == nullptr) {
+            return errorAt("could not determine where this member function comes from", member_function);
+        }
+
+        // function does not exist or function has no owner or the owner has no member function of this name
+        if (function == NO_NODE || flat->functions[function].owner == NO_TOKEN || operand_type->type_name->symbol != tokens.symbol(flat->functions[function].owner)) {
+            return errorAt("`" + std::string(operand_type->type_name->lexeme) + "` does not have a member function `" + std::string(tokens.lexeme(member_function)) + "()`", member_function);
+        }
+
+        if (operand_type->dimensions != 0) {
+            return errorAt("array types do not have member functions: " + std::to_string(operand_type->dimensions), member_function);
+        }
+
+        return getTypeOfFlatCall(symbols, flat->functions[function], function_call.right, member_function);
+    } else {
+        return error("cannot call function", nullptr);
+    }
+}
+
+const DataType* Analyzer::getTypeOfFlatCall(SymbolStack& symbols, const FlatFunction& function, const NodeIndex arguments, const uint32_t name) {
+    const TokenStream& tokens = *module->tokens;
+
+    const uint32_t args_count = arguments == NO_NODE ? 0 : flat->lists[arguments].count;
+    const uint32_t require_args = function.parameters == NO_NODE ? 0 : flat->lists[function.parameters].count;
+
+    if (args_count != require_args) {
+        return errorAt("`" + std::string(tokens.lexeme(function.name)) + "()` requires " + std::to_string(require_args) + " arguments but were given " + std::to_string(args_count), name);
+    }
+
+    for (uint32_t i = 0; i < args_count; ++i) {
+        const DataType* given_type = getTypeOfFlatExpression(symbols, flat->childrenOf(arguments)[i]);
+        const NodeIndex require_type = flat->declarators[flat->childrenOf(function.parameters)[i]].data_type;
+
+        if (!isSameType(given_type, getFlatType(require_type))) {
+            return errorAt("invalid arguments", name);
+        }
+    }
+
+    return getFlatType(function.return_type);
+}
+
+std::nullptr_t Analyzer::errorAt(const std::string& message, const uint32_t token) {
+    const Token located = module->tokens->at(token);
+    return error(message, &located);
+}
+
 std::unique_ptr<SymbolTable> Analyzer::validateSemantics(const std::unique_ptr<Module>& module) {
     Analyzer analyzer(module);
-    return analyzer.has_error ? none() : some(std::move(analyzer.symbol_table));
-} 
\ No newline at end of file
+
+    if (analyzer.has_error) {
+        module->fingerprints = nullptr; // refers to the table dropped
+        return none();
+    }
+
+    return some(std::move(analyzer.owned_table));
+}
+
+std::unique_ptr<FlatSymbolTable> Analyzer::validateFlatSemantics(const std::unique_ptr<Module>& module) {
+    Analyzer analyzer(module);
+    return analyzer.has_error ? none() : some(std::move(analyzer.owned_flat_table));
+}
\ No newline at end of file
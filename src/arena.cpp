@@ -0,0 +1,112 @@
+/// *==============================================================*
+///  arena.cpp
+/// *==============================================================*
+#include "include/arena.hpp"
+
+#include <cstring>
+
+using namespace XC;
+
+Arena::Arena(void)
+    : blocks(),
+      cursor(nullptr),
+      limit(nullptr),
+      objects(0),
+      used(0),
+      reserved(0) {}
+
+std::string_view Arena::copy(const std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+
+    char* memory = (char*) allocate(text.size(), alignof(char));
+    std::memcpy(memory, text.data(), text.size());
+
+    return std::string_view(memory, text.size());
+}
+
+void* Arena::allocate(const size_t size, const size_t alignment) {
+    const uintptr_t address = (uintptr_t) cursor;
+    const size_t padding = (alignment - (address % alignment)) % alignment;
+
+    if (cursor == nullptr || size + padding > (size_t) (limit - cursor)) {
+        // Requests larger than a quarter block get one of their own so the
+        // current block is not abandoned half full
+        if (size > BLOCK_SIZE / 4) {
+            used += size;
+            return allocateBlock(size);
+        }
+
+        cursor = (char*) allocateBlock(BLOCK_SIZE);
+        limit = cursor + BLOCK_SIZE;
+
+        return allocate(size, alignment);
+    }
+
+    void* memory = cursor + padding;
+
+    cursor += padding + size;
+    used += padding + size;
+
+    return memory;
+}
+
+bool Arena::extend(const void* memory, const size_t size, const size_t more) {
+    if ((const char*) memory + size != cursor || more > (size_t) (limit - cursor)) {
+        return false;
+    }
+
+    cursor += more;
+    used += more;
+
+    return true;
+}
+
+void Arena::absorb(Arena& other) {
+    // Blocks never move, so pointers into them stay valid. The current block
+    // is kept as is, the absorbed ones are only held.
+    for (std::unique_ptr<char[]>& block : other.blocks) {
+        blocks.push_back(std::move(block));
+    }
+
+    objects += other.objects;
+    used += other.used;
+    reserved += other.reserved;
+
+    other.blocks.clear();
+    other.cursor = nullptr;
+    other.limit = nullptr;
+    other.objects = 0;
+    other.used = 0;
+    other.reserved = 0;
+}
+
+void Arena::clear(void) {
+    blocks.clear();
+    cursor = nullptr;
+    limit = nullptr;
+    objects = 0;
+    used = 0;
+    reserved = 0;
+}
+
+void* Arena::allocateBlock(const size_t size) {
+    // `new char[]` is aligned for any fundamental type
+    blocks.emplace_back(new char[size]);
+    reserved += size;
+
+    return blocks.back().get();
+}
+
+uint64_t Arena::objectCount(void) const {
+    return objects;
+}
+
+uint64_t Arena::bytesUsed(void) const {
+    return used;
+}
+
+uint64_t Arena::bytesReserved(void) const {
+    return reserved;
+}
@@ -5,65 +5,54 @@
 
 using namespace XC;
 
-Expression* XC::newBinaryExpression(OperatorToken* _operator, Expression* left_operand, Expression* right_operand) {
-    BinaryExpression* binary = new BinaryExpression;
-    ErrorNode* errors = new ErrorNode;
+Expression* XC::newBinaryExpression(Arena& arena, OperatorToken* _operator, Expression* left_operand, Expression* right_operand) {
+    BinaryExpression* binary = arena.make<BinaryExpression>();
+    ErrorNode errors;
 
     binary->operation = _operator;
 
     binary->left_operand = left_operand;
     if (ErrorNode* error_in_left_operand = get_node_if(binary->left_operand, ErrorNode)) {
         binary->left_operand = nullptr;
-        errors->appendError(error_in_left_operand);
+        errors.appendError(error_in_left_operand);
     }
 
     binary->right_operand = right_operand;
     if (ErrorNode* error_in_right_operand = get_node_if(binary->right_operand, ErrorNode)) {
         binary->right_operand = nullptr;
-        errors->appendError(error_in_right_operand);
+        errors.appendError(error_in_right_operand);
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete binary;
-            return (Expression*) errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return (Expression*) errors_found;
     }
 
     return binary;
 }
 
-Expression* XC::newPrefixExpression(OperatorToken* _operator, Expression* operand) {
-    PrefixUnaryExpression* prefix = new PrefixUnaryExpression;
+Expression* XC::newPrefixExpression(Arena& arena, OperatorToken* _operator, Expression* operand) {
+    if (ErrorNode* error = get_node_if(operand, ErrorNode)) {
+        return (Expression*) error;
+    }
+
+    PrefixUnaryExpression* prefix = arena.make<PrefixUnaryExpression>();
 
     prefix->operation = _operator;
     prefix->operand = operand;
 
-    if (ErrorNode* error = get_node_if(prefix->operand, ErrorNode)) {
-        prefix->operand = nullptr;
-        delete prefix;
-        return (Expression*) error;
-    }
-
     return prefix;
 }
 
-Expression* XC::newPostfixExpression(OperatorToken* _operator, Expression* operand) {
-    PostfixUnaryExpression* post = new PostfixUnaryExpression;
+Expression* XC::newPostfixExpression(Arena& arena, OperatorToken* _operator, Expression* operand) {
+    if (ErrorNode* error = get_node_if(operand, ErrorNode)) {
+        return (Expression*) error;
+    }
+
+    PostfixUnaryExpression* post = arena.make<PostfixUnaryExpression>();
 
     post->operation = _operator;
     post->operand = operand;
 
-    if (ErrorNode* error = get_node_if(post->operand, ErrorNode)) {
-        post->operand = nullptr;
-        delete post;
-        return (Expression*) error;
-    }
-
     return post;
 }
 
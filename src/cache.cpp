@@ -0,0 +1,831 @@
+/// *==============================================================*
+///  cache.cpp
+/// *==============================================================*
+#include "include/cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define XC_HAS_MMAP 1
+#endif
+
+using namespace XC;
+
+// Bumped whenever the layout of an entry changes
+static constexpr uint32_t CACHE_FORMAT = 1;
+
+static constexpr char CACHE_MAGIC[4] = {'X', 'C', 'C', '\n'};
+
+// An entry is the header followed by three varint encoded sections: the
+// names in id order, the token stream, and the tree in preorder. Offsets,
+// token indices and lines are stored as deltas so most take a single byte.
+// The sections are still checked while loading, the checksum only makes
+// damage that happens to decode well-formed show up as a miss too.
+struct Header {
+    char magic[4];
+    uint32_t format;
+    uint64_t key;
+    uint64_t content_size;
+    uint64_t checksum; // of everything after the header
+};
+
+uint64_t XC::hashContent(const std::string_view content, uint64_t hash) {
+    size_t index = 0;
+
+    for (; index + sizeof(uint64_t) <= content.size(); index += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, content.data() + index, sizeof(uint64_t));
+        hash = mixHash(hash, word);
+    }
+
+    for (; index < content.size(); ++index) {
+        hash = mixHash(hash, (uint8_t) content[index]);
+    }
+
+    return mixHash(hash, content.size());
+}
+
+uint64_t XC::compilerKey(const uint32_t format) {
+#ifdef XC_HAS_MMAP
+    struct stat compiler;
+
+    // The compiler binary stands in for its version, rebuilding it changes
+    // its modification time
+    if (stat("/proc/self/exe", &compiler) != 0) {
+        return 0;
+    }
+
+    return mixHash(mixHash(mixHash(format, compiler.st_size), compiler.st_mtime), compiler.st_ino);
+#else
+    return 0;
+#endif
+}
+
+/// @return whether a node of the type can stand where `kind` is expected
+static bool isKindOf(const ASTType type, const ASTType kind) {
+    switch (kind) {
+        case ASTType::Declaration:
+            return type == ASTType::Function || type == ASTType::Structure;
+        case ASTType::Statement:
+            return type >= ASTType::VariableDeclarationStatement && type <= ASTType::ForIteration;
+        case ASTType::Expression:
+            return type >= ASTType::PrefixUnaryExpression && type <= ASTType::ArrayAccess;
+        default:
+            return type == kind;
+    }
+}
+
+// <*> ================================================================ <*>
+
+struct Cache::Writer {
+    const SourceFile& source;
+    const TokenStream& tokens;
+
+    std::string bytes;
+    bool complete; // `false` -> something the format has no room for was met
+
+    uint32_t last_index; // of the previous token referenced by the tree
+    uint32_t last_line;
+
+    Writer(const std::unique_ptr<Module>& module)
+        : source(*module->source),
+          tokens(*module->tokens),
+          bytes(),
+          complete(true),
+          last_index(0),
+          last_line(0) {}
+
+    void byte(const uint8_t value) {
+        bytes.push_back((char) value);
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back((char) (value | 0x80));
+            value >>= 7;
+        }
+
+        bytes.push_back((char) value);
+    }
+
+    void signedVarint(const int64_t value) {
+        varint(((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+    }
+
+    void names(const Interner& names) {
+        varint(names.size());
+
+        for (SymbolId id = 0; id < names.size(); ++id) {
+            const std::string_view name = names.name(id);
+
+            if (name.data() < source.content.data() || name.data() + name.size() > source.content.data() + source.content.size()) {
+                complete = false;
+                return;
+            }
+
+            varint(name.data() - source.content.data());
+            varint(name.size());
+        }
+    }
+
+    void stream(void) {
+        varint(tokens.size());
+
+        uint32_t offset = 0;
+        for (uint32_t index = 0; index < tokens.size(); ++index) {
+            byte((uint8_t) tokens.type(index));
+            varint(tokens.offset(index) - offset);
+            varint(tokens.lexeme(index).size());
+            varint(tokens.symbol(index) == NO_SYMBOL ? 0 : tokens.symbol(index) + 1);
+
+            offset = tokens.offset(index);
+        }
+    }
+
+    // Tokens the tree references are stored by their index in the stream,
+    // along with the line so it needs not be searched for when loading
+    void token(const Token* token) {
+        if (token == nullptr) {
+            varint(0);
+            return;
+        }
+
+        if (token->index >= tokens.size() || token->lexeme.data() != source.content.data() + tokens.offset(token->index)) {
+            complete = false;
+            return;
+        }
+
+        // Zigzag encoded like `signedVarint`, shifted so 0 stays free for nullptr
+        const int64_t delta = (int64_t) token->index - last_index;
+        varint((((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63)) + 1);
+        signedVarint((int64_t) token->line - last_line);
+
+        last_index = token->index;
+        last_line = token->line;
+    }
+
+    template <typename T>
+    void list(const ArenaList<T*>& items) {
+        varint(items.size());
+
+        for (const T* item : items) {
+            node(item);
+        }
+    }
+
+    void node(const AST* node) {
+        if (node == nullptr) {
+            byte((uint8_t) ASTType::AST);
+            return;
+        }
+
+        byte((uint8_t) node->type());
+
+        switch (node->type()) {
+            case ASTType::Program:
+                list(((const Program*) node)->declarations);
+                break;
+            case ASTType::Function: {
+                const Function* function = (const Function*) node;
+                token(function->owner);
+                this->node(function->return_type);
+                token(function->name);
+                this->node(function->parameters);
+                this->node(function->body);
+                break;
+            }
+            case ASTType::Structure: {
+                const Structure* structure = (const Structure*) node;
+                token(structure->name);
+                this->node(structure->members);
+                break;
+            }
+            case ASTType::DataType: {
+                const DataType* data_type = (const DataType*) node;
+                byte(data_type->is_reference);
+                token(data_type->type_name);
+                varint(data_type->dimensions);
+                break;
+            }
+            case ASTType::VariableDeclarator: {
+                const VariableDeclarator* declarator = (const VariableDeclarator*) node;
+                this->node(declarator->data_type);
+                token(declarator->variable_name);
+                break;
+            }
+            case ASTType::StructureMembers:
+                list(((const StructureMembers*) node)->members);
+                break;
+            case ASTType::ParameterList:
+                list(((const ParameterList*) node)->parameters);
+                break;
+            case ASTType::BlockStatement:
+                list(((const BlockStatement*) node)->statements);
+                break;
+            case ASTType::ExpressionList:
+                list(((const ExpressionList*) node)->expressions);
+                break;
+            case ASTType::VariableDeclarationStatement: {
+                const VariableDeclarationStatement* statement = (const VariableDeclarationStatement*) node;
+                this->node(statement->declarator);
+                this->node(statement->initial);
+                break;
+            }
+            case ASTType::ExpressionStatement:
+                this->node(((const ExpressionStatement*) node)->expression);
+                break;
+            case ASTType::ConditionalStatement: {
+                const ConditionalStatement* conditional = (const ConditionalStatement*) node;
+                this->node(conditional->condition);
+                this->node(conditional->body);
+                this->node(conditional->else_case);
+                break;
+            }
+            case ASTType::ReturnStatement:
+                this->node(((const ReturnStatement*) node)->expression);
+                break;
+            case ASTType::ContinueStatement:
+            case ASTType::BreakStatement:
+                break;
+            case ASTType::WhileIteration: {
+                const WhileIteration* iteration = (const WhileIteration*) node;
+                this->node(iteration->condition);
+                this->node(iteration->body);
+                break;
+            }
+            case ASTType::ForIteration: {
+                const ForIteration* iteration = (const ForIteration*) node;
+                this->node(iteration->initial);
+                this->node(iteration->condition);
+                this->node(iteration->update);
+                this->node(iteration->body);
+                break;
+            }
+            case ASTType::PrefixUnaryExpression: {
+                const PrefixUnaryExpression* expression = (const PrefixUnaryExpression*) node;
+                token(expression->operation);
+                this->node(expression->operand);
+                break;
+            }
+            case ASTType::PostfixUnaryExpression: {
+                const PostfixUnaryExpression* expression = (const PostfixUnaryExpression*) node;
+                token(expression->operation);
+                this->node(expression->operand);
+                break;
+            }
+            case ASTType::BinaryExpression: {
+                const BinaryExpression* expression = (const BinaryExpression*) node;
+                token(expression->operation);
+                this->node(expression->left_operand);
+                this->node(expression->right_operand);
+                break;
+            }
+            case ASTType::LiteralExpression:
+                token(((const LiteralExpression*) node)->value);
+                break;
+            case ASTType::NumberConstant:
+                token(((const NumberConstant*) node)->value);
+                break;
+            case ASTType::IdentifierConstant:
+                token(((const IdentifierConstant*) node)->value);
+                break;
+            case ASTType::MemberAccess: {
+                const MemberAccess* access = (const MemberAccess*) node;
+                this->node(access->owner);
+                token(access->member);
+                break;
+            }
+            case ASTType::FunctionCall: {
+                const FunctionCall* call = (const FunctionCall*) node;
+                this->node(call->function);
+                this->node(call->arguments);
+                break;
+            }
+            case ASTType::ArrayAccess: {
+                const ArrayAccess* access = (const ArrayAccess*) node;
+                this->node(access->array);
+                this->node(access->index);
+                break;
+            }
+            case ASTType::CastExpression: {
+                const CastExpression* cast = (const CastExpression*) node;
+                this->node(cast->data_type);
+                this->node(cast->expression);
+                break;
+            }
+            default:
+                complete = false;
+                break;
+        }
+    }
+};
+
+// <*> ================================================================ <*>
+
+struct Cache::Reader {
+    const std::unique_ptr<Module>& module;
+    const SourceFile& source;
+    Arena& arena;
+
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool intact; // `false` -> the entry was found to be damaged
+
+    const TokenStream* tokens;
+    uint32_t last_index;
+    uint32_t last_line;
+
+    Reader(const std::unique_ptr<Module>& module, const uint8_t* begin, const uint8_t* end)
+        : module(module),
+          source(*module->source),
+          arena(module->arena),
+          cursor(begin),
+          end(end),
+          intact(true),
+          tokens(nullptr),
+          last_index(0),
+          last_line(0) {}
+
+    uint8_t byte(void) {
+        if (cursor == end) {
+            intact = false;
+            return 0;
+        }
+
+        return *cursor++;
+    }
+
+    uint64_t varint(void) {
+        uint64_t value = 0;
+
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            const uint8_t part = byte();
+            value |= (uint64_t) (part & 0x7F) << shift;
+
+            if ((part & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        intact = false;
+        return 0;
+    }
+
+    int64_t signedVarint(void) {
+        const uint64_t value = varint();
+        return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+    }
+
+    bool names(Interner& names) {
+        const uint64_t count = varint();
+
+        for (uint64_t id = 0; id < count && intact; ++id) {
+            const uint64_t offset = varint();
+            const uint64_t length = varint();
+
+            if (offset + length > source.content.size() || names.intern(source.content.substr(offset, length)) != id) {
+                return false;
+            }
+        }
+
+        return intact;
+    }
+
+    std::unique_ptr<TokenStream> stream(const uint32_t name_count) {
+        const uint64_t count = varint();
+
+        // Every token takes at least four bytes
+        if (count == 0 || count > (uint64_t) (end - cursor) / 4) {
+            return none();
+        }
+
+        std::unique_ptr<TokenStream> stream = std::make_unique<TokenStream>(source);
+        stream->reserve(count);
+
+        uint64_t offset = 0;
+        for (uint64_t index = 0; index < count && intact; ++index) {
+            const uint8_t type = byte();
+            offset += varint();
+            const uint64_t length = varint();
+            const uint64_t symbol = varint();
+
+            if (type >= TOKEN_TYPE_COUNT || offset + length > source.content.size() || symbol > name_count) {
+                return none();
+            }
+
+            stream->append((TokenType) type, offset, length, symbol == 0 ? NO_SYMBOL : symbol - 1);
+        }
+
+        if (!intact || stream->type(count - 1) != TokenType::END_OF_FILE) {
+            return none();
+        }
+
+        return some(stream);
+    }
+
+    Token* token(void) {
+        const uint64_t delta = varint();
+
+        if (delta == 0) {
+            return nullptr;
+        }
+
+        const uint64_t zigzag = delta - 1;
+        const int64_t index = last_index + ((int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1));
+        const int64_t line = last_line + signedVarint();
+
+        if (index < 0 || index >= tokens->size() || line < 0 || line > source.lineCount()) {
+            intact = false;
+            return nullptr;
+        }
+
+        Token* token = arena.make<Token>();
+        token->index = index;
+        token->line = line;
+        token->type = tokens->type(index);
+        token->lexeme = tokens->lexeme(index);
+        token->symbol = tokens->symbol(index);
+
+        // Only past the last line after an unterminated comment, like the stream
+        if (line < source.lineCount()) {
+            const uint32_t offset = tokens->offset(index);
+            const uint32_t line_start = source.line_offsets[line];
+            const bool on_line = offset >= line_start && (line + 1 == source.lineCount() || offset < source.line_offsets[line + 1]);
+
+            if (!on_line) {
+                intact = false;
+                return nullptr;
+            }
+
+            token->column = offset - line_start;
+        } else {
+            token->column = 0;
+        }
+
+        last_index = index;
+        last_line = line;
+
+        return token;
+    }
+
+    template <typename T>
+    void list(ArenaList<T*>& items, const ASTType kind) {
+        const uint64_t count = varint();
+
+        // Every node takes at least a byte
+        if (count > (uint64_t) (end - cursor)) {
+            intact = false;
+            return;
+        }
+
+        for (uint64_t i = 0; i < count && intact; ++i) {
+            if (T* item = (T*) child(kind)) {
+                items.push_back(item);
+            } else {
+                intact = false;
+            }
+        }
+    }
+
+    /// @return the next node, which has to be of the kind unless it is absent
+    AST* child(const ASTType kind) {
+        AST* node = this->node();
+
+        if (node != nullptr && !isKindOf(node->type(), kind)) {
+            intact = false;
+            return nullptr;
+        }
+
+        return node;
+    }
+
+    AST* node(void) {
+        const ASTType type = (ASTType) byte();
+
+        switch (type) {
+            case ASTType::AST:
+                return nullptr;
+            case ASTType::Program: {
+                Program* program = arena.make<Program>();
+                list(program->declarations, ASTType::Declaration);
+                return program;
+            }
+            case ASTType::Function: {
+                Function* function = arena.make<Function>();
+                function->owner = token();
+                function->return_type = (DataType*) child(ASTType::DataType);
+                function->name = token();
+                function->parameters = (ParameterList*) child(ASTType::ParameterList);
+                function->body = (BlockStatement*) child(ASTType::BlockStatement);
+                return function;
+            }
+            case ASTType::Structure: {
+                Structure* structure = arena.make<Structure>();
+                structure->name = token();
+                structure->members = (StructureMembers*) child(ASTType::StructureMembers);
+                return structure;
+            }
+            case ASTType::DataType: {
+                DataType* data_type = arena.make<DataType>();
+                data_type->is_reference = byte() != 0;
+                data_type->type_name = token();
+                data_type->dimensions = varint();
+                return data_type;
+            }
+            case ASTType::VariableDeclarator: {
+                VariableDeclarator* declarator = arena.make<VariableDeclarator>();
+                declarator->data_type = (DataType*) child(ASTType::DataType);
+                declarator->variable_name = token();
+                return declarator;
+            }
+            case ASTType::StructureMembers: {
+                StructureMembers* members = arena.make<StructureMembers>();
+                list(members->members, ASTType::VariableDeclarator);
+                return members;
+            }
+            case ASTType::ParameterList: {
+                ParameterList* parameters = arena.make<ParameterList>();
+                list(parameters->parameters, ASTType::VariableDeclarator);
+                return parameters;
+            }
+            case ASTType::BlockStatement: {
+                BlockStatement* block = arena.make<BlockStatement>();
+                list(block->statements, ASTType::Statement);
+                return block;
+            }
+            case ASTType::ExpressionList: {
+                ExpressionList* expressions = arena.make<ExpressionList>();
+                list(expressions->expressions, ASTType::Expression);
+                return expressions;
+            }
+            case ASTType::VariableDeclarationStatement: {
+                VariableDeclarationStatement* statement = arena.make<VariableDeclarationStatement>();
+                statement->declarator = (VariableDeclarator*) child(ASTType::VariableDeclarator);
+                statement->initial = (Expression*) child(ASTType::Expression);
+                return statement;
+            }
+            case ASTType::ExpressionStatement: {
+                ExpressionStatement* statement = arena.make<ExpressionStatement>();
+                statement->expression = (Expression*) child(ASTType::Expression);
+                return statement;
+            }
+            case ASTType::ConditionalStatement: {
+                ConditionalStatement* conditional = arena.make<ConditionalStatement>();
+                conditional->condition = (Expression*) child(ASTType::Expression);
+                conditional->body = (BlockStatement*) child(ASTType::BlockStatement);
+
+                // `else` holds a block, `else if` the next conditional
+                AST* else_case = node();
+                if (else_case != nullptr && !node_is(else_case, BlockStatement) && !node_is(else_case, ConditionalStatement)) {
+                    intact = false;
+                }
+
+                conditional->else_case = (ConditionalStatement*) else_case;
+                return conditional;
+            }
+            case ASTType::ReturnStatement: {
+                ReturnStatement* statement = arena.make<ReturnStatement>();
+                statement->expression = (Expression*) child(ASTType::Expression);
+                return statement;
+            }
+            case ASTType::ContinueStatement:
+                return arena.make<ContinueStatement>();
+            case ASTType::BreakStatement:
+                return arena.make<BreakStatement>();
+            case ASTType::WhileIteration: {
+                WhileIteration* iteration = arena.make<WhileIteration>();
+                iteration->condition = (Expression*) child(ASTType::Expression);
+                iteration->body = (BlockStatement*) child(ASTType::BlockStatement);
+                return iteration;
+            }
+            case ASTType::ForIteration: {
+                ForIteration* iteration = arena.make<ForIteration>();
+                iteration->initial = (VariableDeclarationStatement*) child(ASTType::VariableDeclarationStatement);
+                iteration->condition = (Expression*) child(ASTType::Expression);
+                iteration->update = (Expression*) child(ASTType::Expression);
+                iteration->body = (BlockStatement*) child(ASTType::BlockStatement);
+                return iteration;
+            }
+            case ASTType::PrefixUnaryExpression: {
+                PrefixUnaryExpression* expression = arena.make<PrefixUnaryExpression>();
+                expression->operation = token();
+                expression->operand = (Expression*) child(ASTType::Expression);
+                return expression;
+            }
+            case ASTType::PostfixUnaryExpression: {
+                PostfixUnaryExpression* expression = arena.make<PostfixUnaryExpression>();
+                expression->operation = token();
+                expression->operand = (Expression*) child(ASTType::Expression);
+                return expression;
+            }
+            case ASTType::BinaryExpression: {
+                BinaryExpression* expression = arena.make<BinaryExpression>();
+                expression->operation = token();
+                expression->left_operand = (Expression*) child(ASTType::Expression);
+                expression->right_operand = (Expression*) child(ASTType::Expression);
+                return expression;
+            }
+            case ASTType::LiteralExpression: {
+                LiteralExpression* literal = arena.make<LiteralExpression>();
+                literal->value = token();
+                return literal;
+            }
+            case ASTType::NumberConstant: {
+                NumberConstant* number = arena.make<NumberConstant>();
+                number->value = token();
+                return number;
+            }
+            case ASTType::IdentifierConstant: {
+                IdentifierConstant* identifier = arena.make<IdentifierConstant>();
+                identifier->value = token();
+                return identifier;
+            }
+            case ASTType::MemberAccess: {
+                MemberAccess* access = arena.make<MemberAccess>();
+                access->owner = (Expression*) child(ASTType::Expression);
+                access->member = token();
+                return access;
+            }
+            case ASTType::FunctionCall: {
+                FunctionCall* call = arena.make<FunctionCall>();
+                call->function = (Expression*) child(ASTType::Expression);
+                call->arguments = (ExpressionList*) child(ASTType::ExpressionList);
+                return call;
+            }
+            case ASTType::ArrayAccess: {
+                ArrayAccess* access = arena.make<ArrayAccess>();
+                access->array = (Expression*) child(ASTType::Expression);
+                access->index = (Expression*) child(ASTType::Expression);
+                return access;
+            }
+            case ASTType::CastExpression: {
+                CastExpression* cast = arena.make<CastExpression>();
+                cast->data_type = (DataType*) child(ASTType::DataType);
+                cast->expression = (Expression*) child(ASTType::Expression);
+                return cast;
+            }
+            default:
+                intact = false;
+                return nullptr;
+        }
+    }
+
+    /// Moves the names, tokens and tree into the module if all of them were intact
+    bool restore(void) {
+        Interner names;
+        if (!this->names(names)) {
+            return false;
+        }
+
+        std::unique_ptr<TokenStream> stream = this->stream(names.size());
+        if (stream == nullptr) {
+            return false;
+        }
+
+        tokens = stream.get();
+
+        Program* program = (Program*) child(ASTType::Program);
+        if (!intact || program == nullptr || cursor != end) {
+            return false;
+        }
+
+        module->names = std::move(names);
+        module->tokens = std::move(stream);
+        module->program = program;
+
+        return true;
+    }
+};
+
+// <*> ================================================================ <*>
+
+Cache::Cache(const std::unique_ptr<Module>& module)
+    : module(module),
+      key(0),
+      path() {
+#ifdef XC_HAS_MMAP
+    const std::string& directory = module->options.cache_directory;
+
+    if (directory.empty() || (key = compilerKey(CACHE_FORMAT)) == 0) {
+        return;
+    }
+
+    key = hashContent(module->source->content, key);
+
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", (unsigned long long) key);
+
+    path = directory + '/' + name + ".xcc";
+#endif
+}
+
+bool Cache::isEnabled(void) const {
+    return !path.empty();
+}
+
+bool Cache::load(void) {
+#ifdef XC_HAS_MMAP
+    if (path.empty()) {
+        return false;
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const uint8_t* begin = (const uint8_t*) mapping;
+
+    Header header;
+    std::memcpy(&header, begin, sizeof(Header));
+
+    bool restored = false;
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 && header.format == CACHE_FORMAT
+        && header.key == key && header.content_size == module->source->content.size()
+        && header.checksum == hashContent(std::string_view((const char*) begin + sizeof(Header), size - sizeof(Header)), 0)) {
+        Reader reader(module, begin + sizeof(Header), begin + size);
+        restored = reader.restore();
+    }
+
+    munmap(mapping, size);
+
+    return restored;
+#else
+    return false;
+#endif
+}
+
+bool Cache::store(void) {
+#ifdef XC_HAS_MMAP
+    // Streaming leaves no token stream behind to store
+    if (path.empty() || module->tokens == nullptr || module->program == nullptr) {
+        return false;
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.format = CACHE_FORMAT;
+    header.key = key;
+    header.content_size = module->source->content.size();
+
+    Writer writer(module);
+    writer.bytes.append((const char*) &header, sizeof(Header));
+
+    writer.names(module->names);
+    writer.stream();
+    writer.node(module->program);
+
+    if (!writer.complete) {
+        return false;
+    }
+
+    header.checksum = hashContent(std::string_view(writer.bytes).substr(sizeof(Header)), 0);
+    std::memcpy(&writer.bytes[0], &header, sizeof(Header));
+
+    mkdir(module->options.cache_directory.c_str(), 0777);
+
+    // Written aside and renamed over the entry, so a compile running at the
+    // same time never maps a half written one
+    const std::string temporary = path + '.' + std::to_string(getpid());
+
+    std::ofstream outfile(temporary, std::ios::binary);
+
+    if (!outfile.is_open()) {
+        return false;
+    }
+
+    outfile.write(writer.bytes.data(), writer.bytes.size());
+    outfile.close();
+
+    if (!outfile || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
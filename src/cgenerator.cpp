@@ -23,32 +23,37 @@ void CGenerator::generate(void) {
     writeLine("#include <stdint.h>\n#include <stdbool.h>\n#include <stdlib.h>\n#include <stddef.h>");
     writeLine("");
 
-    generateStructureDeclaration();
-    generateFunctionDeclaration();
-    generateStructureImplementation();
-    generateFunctionImplementation();
+    if (module->flat != nullptr) {
+        generateFlatStructureDeclaration();
+        generateFlatFunctionDeclaration();
+        generateFlatStructureImplementation();
+        generateFlatFunctionImplementation();
+    } else {
+        generateStructureDeclaration();
+        generateFunctionDeclaration();
+        generateStructureImplementation();
+        generateFunctionImplementation();
+    }
 
     writeLine("// -- END OF AUTO-GENERATED CODE -- ");
     
-    // for (const std::string& line : code->content) {
-    //     std::cout << line << std::endl;
-    // }
+    // std::cout << code->content;
 }
 
 void CGenerator::writeLine(const std::string& line) {
-    code->content.push_back(std::string(indention_level * 4, ' ') + line);
+    code->appendLine(std::string(indention_level * 4, ' ') + line);
 }
 
 void CGenerator::generateStructureDeclaration(void) {
-    const std::vector<Structure*> structures = module->symbols->getAllStructures();
+    const std::vector<Structure*>& structures = module->symbols->getAllStructures();
     for (const Structure* structure : structures) {
-        writeLine("typedef struct " + structure->name->lexeme + " " + structure->name->lexeme + ";");
+        writeLine("typedef struct " + std::string(structure->name->lexeme) + " " + std::string(structure->name->lexeme) + ";");
     }
     writeLine("");
 }
 
 void CGenerator::generateFunctionDeclaration(void) {
-    const std::vector<Function*> functions = module->symbols->getAllFunctions();
+    const std::vector<Function*>& functions = module->symbols->getAllFunctions();
     for (const Function* function : functions) {
         writeLine(translateFunctionSignature(function) + ";");
     }
@@ -56,19 +61,25 @@ void CGenerator::generateFunctionDeclaration(void) {
 }
 
 void CGenerator::generateStructureImplementation(void) {
-    const std::vector<Structure*> structures = module->symbols->getAllStructures();
-    for (const Structure* structure : structures) {
-        writeLine("struct " + structure->name->lexeme);
+    const std::vector<Structure*>& structures = module->symbols->getAllStructures();
+    const bool reorders = module->options.reorder_members && module->layouts != nullptr;
+
+    for (uint32_t index = 0; index < structures.size(); ++index) {
+        const Structure* structure = structures[index];
+
+        writeLine("struct " + std::string(structure->name->lexeme));
         writeLine("{");
         addIndentation();
 
         if (structure->members != nullptr) {
-            const std::vector<VariableDeclarator*> members = structure->members->members;
-            for (const VariableDeclarator* member : members) {
+            const ArenaList<VariableDeclarator*>& members = structure->members->members;
+            for (uint32_t position = 0; position < members.size(); ++position) {
+                const VariableDeclarator* member = members[reorders ? module->layouts->layoutOf(index).packed_order[position] : position];
+
                 std::string buffer;
                 buffer.append(translateDataType(member->data_type));
                 buffer.push_back(' ');
-                buffer.append(member->variable_name->lexeme + ";");
+                buffer.append(std::string(member->variable_name->lexeme) + ";");
                 writeLine(buffer);
             }
         }
@@ -81,13 +92,30 @@ void CGenerator::generateStructureImplementation(void) {
 }
 
 void CGenerator::generateFunctionImplementation(void) {
-    const std::vector<Function*> functions = module->symbols->getAllFunctions();
-    for (const Function* function : functions) {
+    const std::vector<Function*>& functions = module->symbols->getAllFunctions();
+    Fingerprints* fingerprints = module->fingerprints.get();
+
+    for (uint32_t index = 0; index < functions.size(); ++index) {
+        const Function* function = functions[index];
+
+        // A function unchanged since the last compile comes out the same
+        const std::string_view reused = fingerprints != nullptr ? fingerprints->reusedCode(index) : std::string_view();
+        if (!reused.empty()) {
+            code->appendLines(reused);
+            continue;
+        }
+
+        const size_t start = code->content.size();
+
         writeLine(translateFunctionSignature(function));
 
         generateBlockStatement(function->body);
 
         writeLine("");
+
+        if (fingerprints != nullptr) {
+            fingerprints->generated(index, code->content.substr(start));
+        }
     }
     writeLine("");
 }
@@ -96,7 +124,7 @@ void CGenerator::generateBlockStatement(const BlockStatement* block) {
     writeLine("{");
     addIndentation();
 
-    const std::vector<Statement*> statements = block->statements;
+    const ArenaList<Statement*>& statements = block->statements;
     for (const Statement* statement : statements) {
         generateStatement(statement);
     }
@@ -110,48 +138,75 @@ void CGenerator::generateStatement(const Statement* statement) {
         return;
     }
 
-    if (const ExpressionStatement* expression_statement = get_node_if(statement, ExpressionStatement)) {
-        writeLine(translateExpression(expression_statement->expression) + ";"); 
-    } 
-    else if (const VariableDeclarationStatement* variable_declaration = get_node_if(statement, VariableDeclarationStatement)) {
-        writeLine(translateVariableDeclaration(variable_declaration) + ";");
-    } else if (const ConditionalStatement* conditional_statement = get_node_if(statement, ConditionalStatement)) {
-        writeLine("if (" + translateExpression(conditional_statement->condition)  +")");
-        generateBlockStatement(conditional_statement->body);
+    switch (statement->type()) {
+        case ASTType::ExpressionStatement: {
+            const ExpressionStatement* expression_statement = (const ExpressionStatement*) statement;
 
-        if (conditional_statement->else_case != nullptr) {
-            writeLine("else");
+            writeLine(translateExpression(expression_statement->expression) + ";"); 
+            break;
+        }
+        case ASTType::VariableDeclarationStatement: {
+            const VariableDeclarationStatement* variable_declaration = (const VariableDeclarationStatement*) statement;
 
-            if (const BlockStatement* else_case = get_node_if(conditional_statement->else_case, BlockStatement)) {
-                generateBlockStatement(else_case);
-            } else {
-                generateStatement(conditional_statement->else_case);
+            writeLine(translateVariableDeclaration(variable_declaration) + ";");
+            break;
+        }
+        case ASTType::ConditionalStatement: {
+            const ConditionalStatement* conditional_statement = (const ConditionalStatement*) statement;
+
+            writeLine("if (" + translateExpression(conditional_statement->condition)  +")");
+            generateBlockStatement(conditional_statement->body);
+
+            if (conditional_statement->else_case != nullptr) {
+                writeLine("else");
+
+                if (const BlockStatement* else_case = get_node_if(conditional_statement->else_case, BlockStatement)) {
+                    generateBlockStatement(else_case);
+                } else {
+                    generateStatement(conditional_statement->else_case);
+                }
             }
+            break;
         }
-    } else if (const WhileIteration* while_iteration = get_node_if(statement, WhileIteration)) {
-        writeLine("while (" + translateExpression(while_iteration->condition) + ")");
-        generateBlockStatement(while_iteration->body);
-    } else if (const ForIteration* for_iteration = get_node_if(statement, ForIteration)) {
-        std::string buffer;
-        {
-            
-            buffer.append("for (");
-            buffer.append(translateVariableDeclaration(for_iteration->initial) + ";");
-            buffer.append(translateExpression(for_iteration->condition) + ";");
-            buffer.append(translateExpression(for_iteration->update));
-            buffer.append(")");
+        case ASTType::WhileIteration: {
+            const WhileIteration* while_iteration = (const WhileIteration*) statement;
+
+            writeLine("while (" + translateExpression(while_iteration->condition) + ")");
+            generateBlockStatement(while_iteration->body);
+            break;
         }
+        case ASTType::ForIteration: {
+            const ForIteration* for_iteration = (const ForIteration*) statement;
+
+            std::string buffer;
+            {
+                
+                buffer.append("for (");
+                buffer.append(translateVariableDeclaration(for_iteration->initial) + ";");
+                buffer.append(translateExpression(for_iteration->condition) + ";");
+                buffer.append(translateExpression(for_iteration->update));
+                buffer.append(")");
+            }
 
-        writeLine(buffer);
-        generateBlockStatement(for_iteration->body);
-    } else if (const ReturnStatement* return_statement = get_node_if(statement, ReturnStatement)) {
-        writeLine("return " + (return_statement->expression != nullptr ? translateExpression(return_statement->expression) : "") + ";");
-    } else if (node_is(statement, BreakStatement)) {
-        writeLine("break;");
-    } else if (node_is(statement, ContinueStatement)) {
-        writeLine("continue;");
-    } else {
-        error();
+            writeLine(buffer);
+            generateBlockStatement(for_iteration->body);
+            break;
+        }
+        case ASTType::ReturnStatement: {
+            const ReturnStatement* return_statement = (const ReturnStatement*) statement;
+
+            writeLine("return " + (return_statement->expression != nullptr ? translateExpression(return_statement->expression) : "") + ";");
+            break;
+        }
+        case ASTType::BreakStatement:
+            writeLine("break;");
+            break;
+        case ASTType::ContinueStatement:
+            writeLine("continue;");
+            break;
+        default:
+            error();
+            break;
     }
 }
 
@@ -165,26 +220,7 @@ std::string CGenerator::translateDataType(const DataType* data_type) {
         return "void";
     }
 
-    std::string buffer;
-    switch (data_type->type_name->type) {
-        case TokenType::TYPE_BOOL: buffer.append("bool"); break;
-        case TokenType::TYPE_FLOAT: buffer.append("float"); break;
-        case TokenType::TYPE_DOUBLE: buffer.append("double"); break;
-        case TokenType::TYPE_BYTE: buffer.append("int8_t"); break;
-        case TokenType::TYPE_SHORT: buffer.append("int16_t"); break;
-        case TokenType::TYPE_INT: buffer.append("int32_t"); break;
-        case TokenType::TYPE_LONG: buffer.append("int64_t"); break;
-        case TokenType::IDENTIFIER: buffer.append(data_type->type_name->lexeme); break;
-        default: {
-            error();
-        };
-    }
-
-    if (data_type->is_reference) {
-        buffer.push_back('*');
-    }
-
-    return buffer;
+    return translateType(data_type->type_name->type, data_type->type_name->lexeme, data_type->is_reference);
 }
 
 std::string CGenerator::translateFunctionSignature(const Function* function) {
@@ -207,7 +243,7 @@ std::string CGenerator::translateFunctionSignature(const Function* function) {
     // function name
     {
         if (owner != nullptr) {
-            buffer.append(owner->lexeme + "_");
+            buffer.append(std::string(owner->lexeme) + "_");
         }
 
         buffer.append(name->lexeme);
@@ -222,7 +258,7 @@ std::string CGenerator::translateFunctionSignature(const Function* function) {
         }
 
         if (owner != nullptr) {
-            buffer.append(owner->lexeme + "* self");
+            buffer.append(std::string(owner->lexeme) + "* self");
 
             if (parameters != nullptr) {
                 buffer.append(", ");
@@ -235,7 +271,7 @@ std::string CGenerator::translateFunctionSignature(const Function* function) {
                 const IdentifierToken* identifier = parameter->variable_name;
 
                 buffer.append(translateDataType(data_type));
-                buffer.append(" " + identifier->lexeme + ", ");
+                buffer.append(" " + std::string(identifier->lexeme) + ", ");
             }
         }
 
@@ -255,152 +291,110 @@ std::string CGenerator::translateExpression(const Expression* expression) {
         return "";
     }
 
-    if (const PrefixUnaryExpression* prefix = get_node_if(expression, PrefixUnaryExpression)) {
-        std::string op;
-
-        switch (prefix->operation->type) {
-            case TokenType::OP_INCREMENT: op = "++"; break;
-            case TokenType::OP_DECREMENT: op = "--"; break;
-            case TokenType::BOOLEAN_OP_NOT: op = "!"; break;
-            case TokenType::BITWISE_OP_COMPLEMENT: op = "~"; break;
-            case TokenType::ARITHMETIC_OP_SUB: op = "-"; break;
-            case TokenType::BITWISE_OP_AND: op = "&"; break;
-            default: op = error(); break;
-        }
-
-        return "(" + op + translateExpression(prefix->operand) + ")";
-    } else if (const PostfixUnaryExpression* postfix = get_node_if(expression, PostfixUnaryExpression)) {
-        std::string op;
-
-        switch (postfix->operation->type) {
-            case TokenType::OP_INCREMENT: op = "++"; break;
-            case TokenType::OP_DECREMENT: op = "--"; break;
-            default: op = error(); break;
-        }
-
-        return "(" + translateExpression(postfix->operand) + op + ")";
-    } else if (const BinaryExpression* binary = get_node_if(expression, BinaryExpression)) {
-        std::string op;
-
-        switch (binary->operation->type) {
-            case TokenType::ARITHMETIC_OP_ADD: op = "+"; break;
-            case TokenType::ARITHMETIC_OP_SUB: op = "-"; break;
-            case TokenType::ARITHMETIC_OP_MUL: op = "*"; break;
-            case TokenType::ARITHMETIC_OP_DIV: op = "/"; break;
-            case TokenType::ARITHMETIC_OP_MOD: op = "%"; break;
-            case TokenType::BITWISE_OP_AND: op = "&"; break;
-            case TokenType::BITWISE_OP_OR: op = "|"; break;
-            case TokenType::BITWISE_OP_XOR: op = "^"; break;
-            case TokenType::BITWISE_OP_LEFT_SHIFT: op = "<<"; break;
-            case TokenType::BITWISE_OP_RIGHT_SHIFT: op = ">>"; break;
-            case TokenType::RELATIONAL_OP_EQUALITY: op = "=="; break;
-            case TokenType::RELATIONAL_OP_INEQUALITY: op = "!="; break;
-            case TokenType::RELATIONAL_OP_LESS_THAN: op = "<"; break;
-            case TokenType::RELATIONAL_OP_LESS_THAN_EQUAL: op = "<="; break;
-            case TokenType::RELATIONAL_OP_GREATER_THAN: op = ">"; break;
-            case TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL: op = ">="; break;
-            case TokenType::BOOLEAN_OP_AND: op = "&&"; break;
-            case TokenType::BOOLEAN_OP_OR: op = "||"; break;
-            case TokenType::BOOLEAN_OP_XOR: op = "^"; break;
-            case TokenType::ASSIGNMENT_ASSIGN: op = '='; break;
-            case TokenType::ASSIGNMENT_OP_ADD: op = "+="; break;
-            case TokenType::ASSIGNMENT_OP_SUB: op = "-="; break;
-            case TokenType::ASSIGNMENT_OP_MUL: op = "*="; break;
-            case TokenType::ASSIGNMENT_OP_DIV: op = "/="; break;
-            case TokenType::ASSIGNMENT_OP_MOD: op = "%="; break;
-            case TokenType::ASSIGNMENT_OP_AND: op = "&="; break;
-            case TokenType::ASSIGNMENT_OP_OR: op = "|="; break;
-            case TokenType::ASSIGNMENT_OP_XOR: op = "^="; break;
-            case TokenType::ASSIGNMENT_OP_LEFT_SHIFT: op = "<<="; break;
-            case TokenType::ASSIGNMENT_OP_RIGHT_SHIFT: op = ">>="; break;
-            default: op = error(); break;
-        }
-
-        return "(" + translateExpression(binary->left_operand) + " " + op + " " + translateExpression(binary->right_operand) + ")";
-    } else if (const LiteralExpression* literal = get_node_if(expression, LiteralExpression)) {
-        switch (literal->value->type) {
-            case TokenType::LITERAL_BOOLEAN_TRUE: return "true";
-            case TokenType::LITERAL_BOOLEAN_FALSE: return "false";
-            case TokenType::LITERAL_REFERENCE_NULL: return "NULL";
-            default: return error();
-        }
-
-    } else if (const NumberConstant* number = get_node_if(expression, NumberConstant)) {
-        switch (number->value->type) {
-            case TokenType::INTEGER_LITERAL: {
-                std::string num = number->value->lexeme;
-
-                if (num.size() > 2 && num.at(0) == '0' && num.at(1) == 'o') {
-                    num.at(1) = '0';
+    switch (expression->type()) {
+        case ASTType::PrefixUnaryExpression: {
+            const PrefixUnaryExpression* prefix = (const PrefixUnaryExpression*) expression;
+
+            const std::string op = translatePrefixOperator(prefix->operation->type);
+
+            return "(" + op + translateExpression(prefix->operand) + ")";
+        }
+        case ASTType::PostfixUnaryExpression: {
+            const PostfixUnaryExpression* postfix = (const PostfixUnaryExpression*) expression;
+
+            const std::string op = translatePostfixOperator(postfix->operation->type);
+
+            return "(" + translateExpression(postfix->operand) + op + ")";
+        }
+        case ASTType::BinaryExpression: {
+            const BinaryExpression* binary = (const BinaryExpression*) expression;
+
+            const std::string op = translateBinaryOperator(binary->operation->type);
+
+            return "(" + translateExpression(binary->left_operand) + " " + op + " " + translateExpression(binary->right_operand) + ")";
+        }
+        case ASTType::LiteralExpression: {
+            const LiteralExpression* literal = (const LiteralExpression*) expression;
+
+            return translateConstant(literal->value->type, literal->value->lexeme);
+        }
+        case ASTType::NumberConstant: {
+            const NumberConstant* number = (const NumberConstant*) expression;
+
+            return translateConstant(number->value->type, number->value->lexeme);
+        }
+        case ASTType::FunctionCall: {
+            const FunctionCall* function_call = (const FunctionCall*) expression;
+
+            std::string function_name;
+            std::string arguments;
+            if (const MemberAccess* member_function = get_node_if(function_call->function, MemberAccess)) {
+                if (member_function->owner->evaluated_type == nullptr) {
+                    return error();
                 }
 
-                return num;
-            }
-            case TokenType::FLOAT_LITERAL: {
-                return number->value->lexeme + "f";
-            }
-            default: return error();
-        }
-    } else if (const FunctionCall* function_call = get_node_if(expression, FunctionCall)) {
-        std::string function_name;
-        std::string arguments;
-        if (const MemberAccess* member_function = get_node_if(function_call->function, MemberAccess)) {
-            if (member_function->owner->evaluated_type == nullptr) {
-                return error();
-            }
+                function_name = std::string(member_function->owner->evaluated_type->type_name->lexeme) + "_" + std::string(member_function->member->lexeme);
+                arguments.push_back('(');
 
-            function_name = member_function->owner->evaluated_type->type_name->lexeme + "_" + member_function->member->lexeme;
-            arguments.push_back('(');
+                // A reference variable is translated dereferenced, so it needs its address taken too
+                const bool is_pointer = member_function->owner->evaluated_type->is_reference && !node_is(member_function->owner, IdentifierConstant);
 
-            arguments.append((member_function->owner->evaluated_type->is_reference ? "" : "&") + translateExpression(member_function->owner) + ", ");
+                arguments.append((is_pointer ? "" : "&") + translateExpression(member_function->owner) + ", ");
 
-            if (function_call->arguments != nullptr) {
-                const std::vector<Expression*> args = function_call->arguments->expressions;
+                if (function_call->arguments != nullptr) {
+                    const ArenaList<Expression*>& args = function_call->arguments->expressions;
+
+                    for (const Expression* arg : args) {
+                        arguments.append(translateExpression(arg) + ", ");
+                    }
 
-                for (const Expression* arg : args) {
-                    arguments.append(translateExpression(arg) + ", ");
                 }
 
-            }
+                if (arguments.back() == ' ') {
+                    arguments.pop_back();
+                    arguments.pop_back();
+                }
 
-            if (arguments.back() == ' ') {
-                arguments.pop_back();
-                arguments.pop_back();
-            }
+                arguments.push_back(')');
+            } else {
+                function_name = translateExpression(function_call->function);
+                arguments.push_back('(');
 
-            arguments.push_back(')');
-        } else {
-            function_name = translateExpression(function_call->function);
-            arguments.push_back('(');
+                if (function_call->arguments != nullptr) {
+                    const ArenaList<Expression*>& args = function_call->arguments->expressions;
 
-            if (function_call->arguments != nullptr) {
-                const std::vector<Expression*> args = function_call->arguments->expressions;
+                    for (const Expression* arg : args) {
+                        arguments.append(translateExpression(arg) + ", ");
+                    }
 
-                for (const Expression* arg : args) {
-                    arguments.append(translateExpression(arg) + ", ");
                 }
 
-            }
+                if (arguments.back() == ' ') {
+                    arguments.pop_back();
+                    arguments.pop_back();
+                }
 
-            if (arguments.back() == ' ') {
-                arguments.pop_back();
-                arguments.pop_back();
+                arguments.push_back(')');
             }
 
-            arguments.push_back(')');
+
+            return function_name + arguments;
         }
+        case ASTType::MemberAccess: {
+            const MemberAccess* member_access = (const MemberAccess*) expression;
 
+            return "(" + translateExpression(member_access->owner) + "." + std::string(member_access->member->lexeme) + ")";
+        }
+        case ASTType::IdentifierConstant: {
+            const IdentifierConstant* identifier = (const IdentifierConstant*) expression;
 
-        return function_name + arguments;
-    } else if (const MemberAccess* member_access = get_node_if(expression, MemberAccess)) {
-        return "(" + translateExpression(member_access->owner) + "." + member_access->member->lexeme + ")";
-    } else if (const IdentifierConstant* identifier = get_node_if(expression, IdentifierConstant)) {
-        if (identifier->evaluated_type != nullptr && identifier->evaluated_type->is_reference) {
-            return "(*" + identifier->value->lexeme + ")";
+            if (identifier->evaluated_type != nullptr && identifier->evaluated_type->is_reference) {
+                return "(*" + std::string(identifier->value->lexeme) + ")";
+            }
+            return std::string(identifier->value->lexeme);
         }
-        return identifier->value->lexeme;
-    } else {
-        return error();
+        default:
+            return error();
     }
 }
 
@@ -425,6 +419,388 @@ std::string CGenerator::translateVariableDeclaration(const VariableDeclarationSt
     return buffer;
 }
 
+std::string CGenerator::translateType(const TokenType type_name, const std::string_view name, const bool is_reference) {
+    std::string buffer;
+    switch (type_name) {
+        case TokenType::TYPE_BOOL: buffer.append("bool"); break;
+        case TokenType::TYPE_FLOAT: buffer.append("float"); break;
+        case TokenType::TYPE_DOUBLE: buffer.append("double"); break;
+        case TokenType::TYPE_BYTE: buffer.append("int8_t"); break;
+        case TokenType::TYPE_SHORT: buffer.append("int16_t"); break;
+        case TokenType::TYPE_INT: buffer.append("int32_t"); break;
+        case TokenType::TYPE_LONG: buffer.append("int64_t"); break;
+        case TokenType::IDENTIFIER: buffer.append(name); break;
+        default: {
+            error();
+        };
+    }
+
+    if (is_reference) {
+        buffer.push_back('*');
+    }
+
+    return buffer;
+}
+
+std::string CGenerator::translatePrefixOperator(const TokenType operation) {
+    switch (operation) {
+        case TokenType::OP_INCREMENT: return "++";
+        case TokenType::OP_DECREMENT: return "--";
+        case TokenType::BOOLEAN_OP_NOT: return "!";
+        case TokenType::BITWISE_OP_COMPLEMENT: return "~";
+        case TokenType::ARITHMETIC_OP_SUB: return "-";
+        case TokenType::BITWISE_OP_AND: return "&";
+        default: return error();
+    }
+}
+
+std::string CGenerator::translatePostfixOperator(const TokenType operation) {
+    switch (operation) {
+        case TokenType::OP_INCREMENT: return "++";
+        case TokenType::OP_DECREMENT: return "--";
+        default: return error();
+    }
+}
+
+std::string CGenerator::translateBinaryOperator(const TokenType operation) {
+    switch (operation) {
+        case TokenType::ARITHMETIC_OP_ADD: return "+";
+        case TokenType::ARITHMETIC_OP_SUB: return "-";
+        case TokenType::ARITHMETIC_OP_MUL: return "*";
+        case TokenType::ARITHMETIC_OP_DIV: return "/";
+        case TokenType::ARITHMETIC_OP_MOD: return "%";
+        case TokenType::BITWISE_OP_AND: return "&";
+        case TokenType::BITWISE_OP_OR: return "|";
+        case TokenType::BITWISE_OP_XOR: return "^";
+        case TokenType::BITWISE_OP_LEFT_SHIFT: return "<<";
+        case TokenType::BITWISE_OP_RIGHT_SHIFT: return ">>";
+        case TokenType::RELATIONAL_OP_EQUALITY: return "==";
+        case TokenType::RELATIONAL_OP_INEQUALITY: return "!=";
+        case TokenType::RELATIONAL_OP_LESS_THAN: return "<";
+        case TokenType::RELATIONAL_OP_LESS_THAN_EQUAL: return "<=";
+        case TokenType::RELATIONAL_OP_GREATER_THAN: return ">";
+        case TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL: return ">=";
+        case TokenType::BOOLEAN_OP_AND: return "&&";
+        case TokenType::BOOLEAN_OP_OR: return "||";
+        case TokenType::BOOLEAN_OP_XOR: return "^";
+        case TokenType::ASSIGNMENT_ASSIGN: return "=";
+        case TokenType::ASSIGNMENT_OP_ADD: return "+=";
+        case TokenType::ASSIGNMENT_OP_SUB: return "-=";
+        case TokenType::ASSIGNMENT_OP_MUL: return "*=";
+        case TokenType::ASSIGNMENT_OP_DIV: return "/=";
+        case TokenType::ASSIGNMENT_OP_MOD: return "%=";
+        case TokenType::ASSIGNMENT_OP_AND: return "&=";
+        case TokenType::ASSIGNMENT_OP_OR: return "|=";
+        case TokenType::ASSIGNMENT_OP_XOR: return "^=";
+        case TokenType::ASSIGNMENT_OP_LEFT_SHIFT: return "<<=";
+        case TokenType::ASSIGNMENT_OP_RIGHT_SHIFT: return ">>=";
+        default: return error();
+    }
+}
+
+std::string CGenerator::translateConstant(const TokenType type, const std::string_view value) {
+    switch (type) {
+        case TokenType::LITERAL_BOOLEAN_TRUE: return "true";
+        case TokenType::LITERAL_BOOLEAN_FALSE: return "false";
+        case TokenType::LITERAL_REFERENCE_NULL: return "NULL";
+        case TokenType::INTEGER_LITERAL: {
+            std::string num(value);
+
+            if (num.size() > 2 && num.at(0) == '0' && num.at(1) == 'o') {
+                num.at(1) = '0';
+            }
+
+            return num;
+        }
+        case TokenType::FLOAT_LITERAL: {
+            return std::string(value) + "f";
+        }
+        default: return error();
+    }
+}
+
+// <*> ========================= FLAT TREE ========================= <*>
+
+// The walk of a flat tree below writes the same C as the walk of a pointer
+// tree above
+
+void CGenerator::generateFlatStructureDeclaration(void) {
+    const TokenStream& tokens = *module->tokens;
+
+    for (const NodeIndex structure : module->flat_symbols->getAllStructures()) {
+        const std::string name(tokens.lexeme(module->flat->structures[structure].name));
+        writeLine("typedef struct " + name + " " + name + ";");
+    }
+    writeLine("");
+}
+
+void CGenerator::generateFlatFunctionDeclaration(void) {
+    for (const NodeIndex function : module->flat_symbols->getAllFunctions()) {
+        writeLine(translateFlatFunctionSignature(function) + ";");
+    }
+    writeLine("");
+}
+
+void CGenerator::generateFlatStructureImplementation(void) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatTree& flat = *module->flat;
+
+    for (const NodeIndex structure : module->flat_symbols->getAllStructures()) {
+        writeLine("struct " + std::string(tokens.lexeme(flat.structures[structure].name)));
+        writeLine("{");
+        addIndentation();
+
+        for (const NodeIndex member : flat.childrenOf(flat.structures[structure].members)) {
+            writeLine(translateFlatDataType(flat.declarators[member].data_type) + " " + std::string(tokens.lexeme(flat.declarators[member].variable_name)) + ";");
+        }
+
+        removeIndentation();
+        writeLine("};");
+        writeLine("");
+    }
+    writeLine("");
+}
+
+void CGenerator::generateFlatFunctionImplementation(void) {
+    for (const NodeIndex function : module->flat_symbols->getAllFunctions()) {
+        writeLine(translateFlatFunctionSignature(function));
+
+        generateFlatBlockStatement(module->flat->functions[function].body);
+
+        writeLine("");
+    }
+    writeLine("");
+}
+
+void CGenerator::generateFlatBlockStatement(const NodeIndex block) {
+    writeLine("{");
+    addIndentation();
+
+    for (const NodeIndex statement : module->flat->childrenOf(block)) {
+        generateFlatStatement(statement);
+    }
+
+    removeIndentation();
+    writeLine("}");
+}
+
+void CGenerator::generateFlatStatement(const NodeIndex index) {
+    if (index == NO_NODE) {
+        return;
+    }
+
+    const FlatStatement& statement = module->flat->statements[index];
+
+    switch (statement.kind) {
+        case ASTType::ExpressionStatement:
+            writeLine(translateFlatExpression(statement.expression) + ";");
+            break;
+        case ASTType::VariableDeclarationStatement:
+            writeLine(translateFlatVariableDeclaration(index) + ";");
+            break;
+        case ASTType::ConditionalStatement: {
+            writeLine("if (" + translateFlatExpression(statement.expression) + ")");
+            generateFlatBlockStatement(statement.body);
+
+            if (statement.nested != NO_NODE) {
+                writeLine("else");
+
+                const FlatStatement& else_case = module->flat->statements[statement.nested];
+
+                if (else_case.kind == ASTType::BlockStatement) {
+                    generateFlatBlockStatement(else_case.body);
+                } else {
+                    generateFlatStatement(statement.nested);
+                }
+            }
+            break;
+        }
+        case ASTType::WhileIteration:
+            writeLine("while (" + translateFlatExpression(statement.expression) + ")");
+            generateFlatBlockStatement(statement.body);
+            break;
+        case ASTType::ForIteration: {
+            std::string buffer;
+
+            buffer.append("for (");
+            buffer.append(translateFlatVariableDeclaration(statement.nested) + ";");
+            buffer.append(translateFlatExpression(statement.expression) + ";");
+            buffer.append(translateFlatExpression(statement.update));
+            buffer.append(")");
+
+            writeLine(buffer);
+            generateFlatBlockStatement(statement.body);
+            break;
+        }
+        case ASTType::ReturnStatement:
+            writeLine("return " + (statement.expression != NO_NODE ? translateFlatExpression(statement.expression) : "") + ";");
+            break;
+        case ASTType::BreakStatement:
+            writeLine("break;");
+            break;
+        case ASTType::ContinueStatement:
+            writeLine("continue;");
+            break;
+        default:
+            error();
+            break;
+    }
+}
+
+std::string CGenerator::translateFlatDataType(const NodeIndex type) {
+    if (type == NO_NODE) {
+        return "void";
+    }
+
+    const TokenStream& tokens = *module->tokens;
+    const FlatType& data_type = module->flat->types[type];
+
+    return translateType(tokens.type(data_type.type_name), tokens.lexeme(data_type.type_name), data_type.is_reference);
+}
+
+std::string CGenerator::translateFlatFunctionSignature(const NodeIndex index) {
+    const TokenStream& tokens = *module->tokens;
+    const FlatTree& flat = *module->flat;
+    const FlatFunction& function = flat.functions[index];
+
+    std::string buffer;
+
+    buffer.append(translateFlatDataType(function.return_type));
+    buffer.push_back(' ');
+
+    if (function.owner != NO_TOKEN) {
+        buffer.append(std::string(tokens.lexeme(function.owner)) + "_");
+    }
+
+    buffer.append(tokens.lexeme(function.name));
+    buffer.push_back('(');
+
+    if (function.owner == NO_TOKEN && function.parameters == NO_NODE) {
+        buffer.append("void");
+    }
+
+    if (function.owner != NO_TOKEN) {
+        buffer.append(std::string(tokens.lexeme(function.owner)) + "* self");
+
+        if (function.parameters != NO_NODE) {
+            buffer.append(", ");
+        }
+    }
+
+    if (function.parameters != NO_NODE) {
+        for (const NodeIndex parameter : flat.childrenOf(function.parameters)) {
+            buffer.append(translateFlatDataType(flat.declarators[parameter].data_type));
+            buffer.append(" " + std::string(tokens.lexeme(flat.declarators[parameter].variable_name)) + ", ");
+        }
+    }
+
+    if (buffer.back() == ' ') {
+        buffer.pop_back();
+        buffer.pop_back();
+    }
+
+    buffer.push_back(')');
+
+    return buffer;
+}
+
+std::string CGenerator::translateFlatExpression(const NodeIndex index) {
+    if (index == NO_NODE) {
+        return "";
+    }
+
+    const TokenStream& tokens = *module->tokens;
+    const FlatTree& flat = *module->flat;
+    const FlatExpression& expression = flat.expressions[index];
+
+    switch (expression.kind) {
+        case ASTType::PrefixUnaryExpression:
+            return "(" + translatePrefixOperator(tokens.type(expression.token)) + translateFlatExpression(expression.left) + ")";
+        case ASTType::PostfixUnaryExpression:
+            return "(" + translateFlatExpression(expression.left) + translatePostfixOperator(tokens.type(expression.token)) + ")";
+        case ASTType::BinaryExpression: {
+            const std::string op = translateBinaryOperator(tokens.type(expression.token));
+
+            return "(" + translateFlatExpression(expression.left) + " " + op + " " + translateFlatExpression(expression.right) + ")";
+        }
+        case ASTType::LiteralExpression:
+        case ASTType::NumberConstant:
+            return translateConstant(tokens.type(expression.token), tokens.lexeme(expression.token));
+        case ASTType::FunctionCall: {
+            const FlatExpression& called = flat.expressions[expression.left];
+
+            std::string function_name;
+            std::string arguments = "(";
+
+            if (called.kind == ASTType::MemberAccess) {
+                const DataType* owner_type = flat.evaluated_types[called.left];
+
+                if (owner_type == nullptr) {
+                    return error();
+                }
+
+                function_name = std::string(owner_type->type_name->lexeme) + "_" + std::string(tokens.lexeme(called.token));
+
+                // A reference variable is translated dereferenced, so it needs its address taken too
+                const bool is_pointer = owner_type->is_reference && flat.expressions[called.left].kind != ASTType::IdentifierConstant;
+
+                arguments.append((is_pointer ? "" : "&") + translateFlatExpression(called.left) + ", ");
+            } else {
+                function_name = translateFlatExpression(expression.left);
+            }
+
+            if (expression.right != NO_NODE) {
+                for (const NodeIndex argument : flat.childrenOf(expression.right)) {
+                    arguments.append(translateFlatExpression(argument) + ", ");
+                }
+            }
+
+            if (arguments.back() == ' ') {
+                arguments.pop_back();
+                arguments.pop_back();
+            }
+
+            arguments.push_back(')');
+
+            return function_name + arguments;
+        }
+        case ASTType::MemberAccess:
+            return "(" + translateFlatExpression(expression.left) + "." + std::string(tokens.lexeme(expression.token)) + ")";
+        case ASTType::IdentifierConstant: {
+            const DataType* evaluated_type = flat.evaluated_types[index];
+
+            if (evaluated_type != nullptr && evaluated_type->is_reference) {
+                return "(*" + std::string(tokens.lexeme(expression.token)) + ")";
+            }
+            return std::string(tokens.lexeme(expression.token));
+        }
+        default:
+            return error();
+    }
+}
+
+std::string CGenerator::translateFlatVariableDeclaration(const NodeIndex index) {
+    if (index == NO_NODE) {
+        return "";
+    }
+
+    const TokenStream& tokens = *module->tokens;
+    const FlatStatement& declaration = module->flat->statements[index];
+    const FlatDeclarator& variable_declarator = module->flat->declarators[declaration.nested];
+
+    std::string buffer;
+    buffer.append(translateFlatDataType(variable_declarator.data_type));
+    buffer.push_back(' ');
+    buffer.append(tokens.lexeme(variable_declarator.variable_name));
+
+    if (declaration.expression != NO_NODE) {
+        buffer.append(" = ");
+        buffer.append(translateFlatExpression(declaration.expression));
+    }
+
+    return buffer;
+}
+
 void CGenerator::addIndentation(void) {
     ++indention_level;
 }
@@ -0,0 +1,297 @@
+/// *==============================================================*
+///  fingerprints.cpp
+/// *==============================================================*
+#include "include/fingerprints.hpp"
+#include "include/xc.hpp"
+#include "include/cache.hpp"
+
+#include <cstring>
+
+using namespace XC;
+
+// Bumped whenever the layout of a record changes
+static constexpr uint32_t FINGERPRINTS_FORMAT = 1;
+
+static constexpr char FINGERPRINTS_MAGIC[4] = {'X', 'C', 'F', '\n'};
+
+// A record is the header followed by every valid function as its
+// fingerprint, the size of the code generated for it and the code.
+struct FingerprintsHeader {
+    char magic[4];
+    uint32_t format;
+    uint64_t key;
+    uint64_t checksum; // of everything after the header
+};
+
+// Mixed in for a name that refers to a structure, whose members are all in
+// `structures_hash` already, and for a name that refers to nothing
+static constexpr uint64_t NAMES_STRUCTURE = 1;
+static constexpr uint64_t NAMES_NOTHING = 2;
+
+template <typename T>
+static void put(std::string& bytes, const T value) {
+    bytes.append((const char*) &value, sizeof(T));
+}
+
+template <typename T>
+static bool take(const std::string_view bytes, size_t& cursor, T& value) {
+    if (bytes.size() - cursor < sizeof(T)) {
+        return false;
+    }
+
+    std::memcpy(&value, bytes.data() + cursor, sizeof(T));
+    cursor += sizeof(T);
+
+    return true;
+}
+
+Fingerprints::Fingerprints(const std::unique_ptr<Module>& module, SymbolTable& symbols)
+    : module(module),
+      symbols(symbols),
+      path(),
+      key(compilerKey(FINGERPRINTS_FORMAT)),
+      structures_hash(0),
+      signatures(),
+      names(),
+      meanings(),
+      records(symbols.getAllFunctions().size()),
+      previous(),
+      previous_functions() {
+    if (key == 0 || module->tokens == nullptr) {
+        return;
+    }
+
+    // Worked out once per name rather than for every token naming it
+    names.reserve(module->names.size());
+
+    for (SymbolId symbol = 0; symbol < module->names.size(); ++symbol) {
+        names.push_back(hashContent(module->names.name(symbol), 0));
+    }
+
+    if (!locateDeclarations()) {
+        return;
+    }
+
+    // A name means something else once a declaration by it comes or goes
+    meanings.reserve(names.size());
+
+    for (SymbolId symbol = 0; symbol < names.size(); ++symbol) {
+        const Declaration* declaration = symbols.lookup(symbol);
+
+        const uint64_t meaning = declaration == nullptr ? NAMES_NOTHING
+            : node_is(declaration, Structure) ? NAMES_STRUCTURE
+            : signatures.at(symbol);
+
+        meanings.push_back(mixHash(names[symbol], meaning));
+    }
+
+    path = module->source->filename + ".xcf";
+
+    load();
+}
+
+bool Fingerprints::locateDeclarations(void) {
+    const TokenStream& tokens = *module->tokens;
+    const ArenaList<Declaration*>& declarations = module->program->declarations;
+
+    // Declaration k spans the tokens [starts[k], starts[k + 1]), the same as
+    // the reparser finds them
+    std::vector<uint32_t> starts = {0};
+    {
+        uint32_t depth = 0;
+
+        for (uint32_t index = 0; index + 1 < tokens.size(); ++index) {
+            if (tokens.type(index) == TokenType::PUNCTUATION_LEFT_BRACE) {
+                ++depth;
+            } else if (tokens.type(index) == TokenType::PUNCTUATION_RIGHT_BRACE && --depth == 0) {
+                starts.push_back(index + 1);
+            }
+        }
+    }
+
+    if (starts.size() != declarations.size() + 1) {
+        return false;
+    }
+
+    // Every structure counts, a function can reach any of them through the
+    // members of another
+    const std::vector<Function*>& functions = symbols.getAllFunctions();
+    uint32_t next = 0;
+
+    for (uint32_t k = 0; k < declarations.size(); ++k) {
+        if (node_is(declarations[k], Structure)) {
+            structures_hash = hash(starts[k], starts[k + 1], structures_hash, false);
+            continue;
+        }
+
+        // Functions defined twice are not loaded, only the first one is
+        if (next == functions.size() || declarations[k] != functions[next]) {
+            continue;
+        }
+
+        const Function* function = functions[next];
+        Record& record = records[next++];
+        record.first_token = starts[k];
+        record.last_token = starts[k + 1];
+
+        // The signature is all that comes before the body
+        uint32_t body = record.first_token;
+        while (body < record.last_token && tokens.type(body) != TokenType::PUNCTUATION_LEFT_BRACE) {
+            ++body;
+        }
+
+        signatures.emplace(function->name->symbol, hash(record.first_token, body, 0, false));
+    }
+
+    return next == functions.size();
+}
+
+void Fingerprints::load(void) {
+    std::ifstream infile(path, std::ios::binary | std::ios::ate);
+
+    if (!infile || (size_t) infile.tellg() < sizeof(FingerprintsHeader)) {
+        return;
+    }
+
+    previous.resize(infile.tellg());
+    infile.seekg(0);
+    infile.read(previous.data(), previous.size());
+
+    FingerprintsHeader header;
+    std::memcpy(&header, previous.data(), sizeof(FingerprintsHeader));
+
+    if (!infile || std::memcmp(header.magic, FINGERPRINTS_MAGIC, sizeof(FINGERPRINTS_MAGIC)) != 0
+        || header.format != FINGERPRINTS_FORMAT || header.key != key
+        || header.checksum != hashContent(std::string_view(previous).substr(sizeof(FingerprintsHeader)), 0)) {
+        return;
+    }
+
+    size_t cursor = sizeof(FingerprintsHeader);
+    std::unordered_map<uint64_t, std::string_view> functions;
+
+    while (cursor < previous.size()) {
+        uint64_t fingerprint;
+        uint32_t size;
+
+        if (!take(previous, cursor, fingerprint) || !take(previous, cursor, size) || previous.size() - cursor < size) {
+            return;
+        }
+
+        functions.emplace(fingerprint, std::string_view(previous).substr(cursor, size));
+        cursor += size;
+    }
+
+    previous_functions = std::move(functions);
+}
+
+bool Fingerprints::reuse(const uint32_t index) {
+    Record& record = records[index];
+
+    record.valid = false;
+    record.reused = false;
+
+    if (path.empty()) {
+        return false;
+    }
+
+    record.fingerprint = hash(record.first_token, record.last_token, structures_hash, true);
+
+    const auto found = previous_functions.find(record.fingerprint);
+
+    if (found == previous_functions.end()) {
+        return false;
+    }
+
+    record.valid = true;
+    record.reused = true;
+    record.previous_code = found->second;
+
+    return true;
+}
+
+void Fingerprints::validated(const uint32_t index) {
+    records[index].valid = true;
+}
+
+std::string_view Fingerprints::reusedCode(const uint32_t index) const {
+    return records[index].reused ? records[index].previous_code : std::string_view();
+}
+
+void Fingerprints::generated(const uint32_t index, const std::string_view code) {
+    records[index].code = code;
+}
+
+bool Fingerprints::store(void) {
+    if (path.empty()) {
+        return false;
+    }
+
+    std::string bytes;
+    bytes.reserve(previous.size());
+
+    put(bytes, FingerprintsHeader{});
+
+    for (const Record& record : records) {
+        if (!record.valid) {
+            continue;
+        }
+
+        const std::string_view code = record.reused ? record.previous_code : std::string_view(record.code);
+
+        put(bytes, record.fingerprint);
+        put(bytes, (uint32_t) code.size());
+        bytes.append(code);
+    }
+
+    FingerprintsHeader header;
+    std::memcpy(header.magic, FINGERPRINTS_MAGIC, sizeof(FINGERPRINTS_MAGIC));
+    header.format = FINGERPRINTS_FORMAT;
+    header.key = key;
+    header.checksum = hashContent(std::string_view(bytes).substr(sizeof(FingerprintsHeader)), 0);
+    std::memcpy(&bytes[0], &header, sizeof(FingerprintsHeader));
+
+    if (bytes == previous) {
+        return false;
+    }
+
+    std::ofstream outfile(path, std::ios::binary);
+
+    outfile.write(bytes.data(), bytes.size());
+    outfile.close();
+
+    return (bool) outfile;
+}
+
+uint32_t Fingerprints::reusedCount(void) const {
+    uint32_t count = 0;
+
+    for (const Record& record : records) {
+        count += record.reused;
+    }
+
+    return count;
+}
+
+// <*> ================================================================ <*>
+
+uint64_t Fingerprints::hash(uint32_t first, const uint32_t last, uint64_t hash, const bool with_dependency) const {
+    const TokenStream& tokens = *module->tokens;
+
+    for (; first < last; ++first) {
+        const TokenType type = tokens.type(first);
+        const SymbolId symbol = tokens.symbol(first);
+
+        hash = mixHash(hash, (uint64_t) type);
+
+        // Apart from names and numbers, a token is spelled by its type alone
+        if (with_dependency && type == TokenType::IDENTIFIER) {
+            hash = mixHash(hash, meanings[symbol]);
+        } else if (symbol != NO_SYMBOL) {
+            hash = mixHash(hash, names[symbol]);
+        } else if (type >= TokenType::INTEGER_LITERAL && type <= TokenType::CHARACTER_LITERAL) {
+            hash = hashContent(tokens.lexeme(first), hash);
+        }
+    }
+
+    return hash;
+}
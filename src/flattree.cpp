@@ -0,0 +1,311 @@
+/// *==============================================================*
+///  flattree.cpp
+/// *==============================================================*
+#include "include/flattree.hpp"
+
+using namespace XC;
+
+template <typename T>
+static uint64_t bytesOf(const std::vector<T>& nodes) {
+    return nodes.size() * sizeof(T);
+}
+
+template <typename T>
+static uint64_t capacityOf(const std::vector<T>& nodes) {
+    return nodes.capacity() * sizeof(T);
+}
+
+FlatTree::FlatTree(void)
+    : declarations(),
+      functions(),
+      structures(),
+      declarators(),
+      types(),
+      statements(),
+      expressions(),
+      lists(),
+      children(),
+      evaluated_types() {}
+
+void FlatTree::append(const Declaration* declaration) {
+    if (const Function* function = get_node_if(declaration, Function)) {
+        FlatFunction flat;
+
+        flat.owner = function->owner != nullptr ? function->owner->index : NO_TOKEN;
+        flat.return_type = appendType(function->return_type);
+        flat.name = function->name->index;
+        flat.parameters = NO_NODE;
+        flat.body = appendBlock(function->body);
+
+        if (function->parameters != nullptr) {
+            const ArenaList<VariableDeclarator*>& parameters = function->parameters->parameters;
+            const NodeIndex list = appendList(parameters.size());
+
+            for (uint32_t index = 0; index < parameters.size(); ++index) {
+                const NodeIndex parameter = appendDeclarator(parameters[index]);
+                children[lists[list].first + index] = parameter;
+            }
+
+            flat.parameters = list;
+        }
+
+        declarations.push_back({ASTType::Function, (NodeIndex) functions.size()});
+        functions.push_back(flat);
+    } else if (const Structure* structure = get_node_if(declaration, Structure)) {
+        const ArenaList<VariableDeclarator*>& members = structure->members->members;
+        const NodeIndex list = appendList(members.size());
+
+        for (uint32_t index = 0; index < members.size(); ++index) {
+            const NodeIndex member = appendDeclarator(members[index]);
+            children[lists[list].first + index] = member;
+        }
+
+        declarations.push_back({ASTType::Structure, (NodeIndex) structures.size()});
+        structures.push_back({structure->name->index, list});
+    }
+}
+
+FlatChildren FlatTree::childrenOf(const NodeIndex list) const {
+    const NodeIndex* first = children.data() + lists[list].first;
+    return {first, first + lists[list].count};
+}
+
+uint64_t FlatTree::nodeCount(void) const {
+    return functions.size() + structures.size() + declarators.size() + types.size()
+        + statements.size() + expressions.size() + lists.size();
+}
+
+uint64_t FlatTree::bytesUsed(void) const {
+    return bytesOf(declarations) + bytesOf(functions) + bytesOf(structures) + bytesOf(declarators) + bytesOf(types)
+        + bytesOf(statements) + bytesOf(expressions) + bytesOf(lists) + bytesOf(children) + bytesOf(evaluated_types);
+}
+
+uint64_t FlatTree::bytesReserved(void) const {
+    return capacityOf(declarations) + capacityOf(functions) + capacityOf(structures) + capacityOf(declarators) + capacityOf(types)
+        + capacityOf(statements) + capacityOf(expressions) + capacityOf(lists) + capacityOf(children) + capacityOf(evaluated_types);
+}
+
+NodeIndex FlatTree::appendType(const DataType* type) {
+    if (type == nullptr) {
+        return NO_NODE;
+    }
+
+    types.push_back({type->type_name->index, type->dimensions, type->is_reference});
+    return types.size() - 1;
+}
+
+NodeIndex FlatTree::appendDeclarator(const VariableDeclarator* declarator) {
+    const NodeIndex data_type = appendType(declarator->data_type);
+
+    declarators.push_back({data_type, declarator->variable_name->index});
+    return declarators.size() - 1;
+}
+
+NodeIndex FlatTree::appendBlock(const BlockStatement* block) {
+    if (block == nullptr) {
+        return NO_NODE;
+    }
+
+    const ArenaList<Statement*>& block_statements = block->statements;
+    const NodeIndex list = appendList(block_statements.size());
+
+    // The nested lists go after this one, which is filled in as they are
+    for (uint32_t index = 0; index < block_statements.size(); ++index) {
+        const NodeIndex statement = appendStatement(block_statements[index]);
+        children[lists[list].first + index] = statement;
+    }
+
+    return list;
+}
+
+NodeIndex FlatTree::appendStatement(const Statement* statement) {
+    if (statement == nullptr) {
+        return NO_NODE;
+    }
+
+    FlatStatement flat = {statement->type(), NO_NODE, NO_NODE, NO_NODE, NO_NODE};
+
+    switch (statement->type()) {
+        case ASTType::VariableDeclarationStatement: {
+            const VariableDeclarationStatement* variable_declaration = (const VariableDeclarationStatement*) statement;
+
+            flat.nested = appendDeclarator(variable_declaration->declarator);
+            flat.expression = appendExpression(variable_declaration->initial);
+            break;
+        }
+        case ASTType::ExpressionStatement: {
+            flat.expression = appendExpression(((const ExpressionStatement*) statement)->expression);
+            break;
+        }
+        case ASTType::ConditionalStatement: {
+            const ConditionalStatement* conditional = (const ConditionalStatement*) statement;
+
+            flat.expression = appendExpression(conditional->condition);
+            flat.body = appendBlock(conditional->body);
+
+            // An else block is kept as a statement of its own, as an else if is
+            if (const BlockStatement* else_case = get_node_if(conditional->else_case, BlockStatement)) {
+                const NodeIndex body = appendBlock(else_case);
+
+                statements.push_back({ASTType::BlockStatement, NO_NODE, NO_NODE, body, NO_NODE});
+                flat.nested = statements.size() - 1;
+            } else {
+                flat.nested = appendStatement(conditional->else_case);
+            }
+            break;
+        }
+        case ASTType::WhileIteration: {
+            const WhileIteration* while_iteration = (const WhileIteration*) statement;
+
+            flat.expression = appendExpression(while_iteration->condition);
+            flat.body = appendBlock(while_iteration->body);
+            break;
+        }
+        case ASTType::ForIteration: {
+            const ForIteration* for_iteration = (const ForIteration*) statement;
+
+            flat.nested = appendStatement(for_iteration->initial);
+            flat.expression = appendExpression(for_iteration->condition);
+            flat.update = appendExpression(for_iteration->update);
+            flat.body = appendBlock(for_iteration->body);
+            break;
+        }
+        case ASTType::ReturnStatement: {
+            flat.expression = appendExpression(((const ReturnStatement*) statement)->expression);
+            break;
+        }
+        default:
+            break;
+    }
+
+    statements.push_back(flat);
+    return statements.size() - 1;
+}
+
+NodeIndex FlatTree::appendExpression(const Expression* expression) {
+    if (expression == nullptr) {
+        return NO_NODE;
+    }
+
+    FlatExpression flat = {expression->type(), NO_TOKEN, NO_NODE, NO_NODE};
+
+    switch (expression->type()) {
+        case ASTType::PrefixUnaryExpression: {
+            const PrefixUnaryExpression* prefix = (const PrefixUnaryExpression*) expression;
+
+            flat.token = prefix->operation->index;
+            flat.left = appendExpression(prefix->operand);
+            break;
+        }
+        case ASTType::PostfixUnaryExpression: {
+            const PostfixUnaryExpression* postfix = (const PostfixUnaryExpression*) expression;
+
+            flat.token = postfix->operation->index;
+            flat.left = appendExpression(postfix->operand);
+            break;
+        }
+        case ASTType::BinaryExpression: {
+            const BinaryExpression* binary = (const BinaryExpression*) expression;
+
+            flat.token = binary->operation->index;
+            flat.left = appendExpression(binary->left_operand);
+            flat.right = appendExpression(binary->right_operand);
+            break;
+        }
+        case ASTType::LiteralExpression: {
+            flat.token = ((const LiteralExpression*) expression)->value->index;
+            break;
+        }
+        case ASTType::NumberConstant: {
+            flat.token = ((const NumberConstant*) expression)->value->index;
+            break;
+        }
+        case ASTType::IdentifierConstant: {
+            flat.token = ((const IdentifierConstant*) expression)->value->index;
+            break;
+        }
+        case ASTType::MemberAccess: {
+            const MemberAccess* member_access = (const MemberAccess*) expression;
+
+            flat.token = member_access->member->index;
+            flat.left = appendExpression(member_access->owner);
+            break;
+        }
+        case ASTType::FunctionCall: {
+            const FunctionCall* function_call = (const FunctionCall*) expression;
+
+            flat.left = appendExpression(function_call->function);
+
+            if (function_call->arguments != nullptr) {
+                const ArenaList<Expression*>& arguments = function_call->arguments->expressions;
+                const NodeIndex list = appendList(arguments.size());
+
+                for (uint32_t index = 0; index < arguments.size(); ++index) {
+                    const NodeIndex argument = appendExpression(arguments[index]);
+                    children[lists[list].first + index] = argument;
+                }
+
+                flat.right = list;
+            }
+            break;
+        }
+        case ASTType::ArrayAccess: {
+            const ArrayAccess* array_access = (const ArrayAccess*) expression;
+
+            flat.left = appendExpression(array_access->array);
+            flat.right = appendExpression(array_access->index);
+            break;
+        }
+        default:
+            break;
+    }
+
+    expressions.push_back(flat);
+    return expressions.size() - 1;
+}
+
+NodeIndex FlatTree::appendList(const uint32_t count) {
+    lists.push_back({(uint32_t) children.size(), count});
+    children.resize(children.size() + count, NO_NODE);
+
+    return lists.size() - 1;
+}
+
+FlatSymbolTable::FlatSymbolTable(void)
+    : symbols(),
+      functions(),
+      structures() {}
+
+const std::vector<NodeIndex>& FlatSymbolTable::getAllFunctions(void) const {
+    return functions;
+}
+
+const std::vector<NodeIndex>& FlatSymbolTable::getAllStructures(void) const {
+    return structures;
+}
+
+bool FlatSymbolTable::loadFunction(const SymbolId name, const NodeIndex function) {
+    if (symbols.try_emplace(name, FlatDeclaration {ASTType::Function, function}).second) {
+        functions.push_back(function);
+        return true;
+    }
+    return false;
+}
+
+bool FlatSymbolTable::loadStructure(const SymbolId name, const NodeIndex structure) {
+    if (symbols.try_emplace(name, FlatDeclaration {ASTType::Structure, structure}).second) {
+        structures.push_back(structure);
+        return true;
+    }
+    return false;
+}
+
+NodeIndex FlatSymbolTable::lookupFunction(const SymbolId identifier) const {
+    const auto found = symbols.find(identifier);
+    return found != symbols.end() && found->second.kind == ASTType::Function ? found->second.node : NO_NODE;
+}
+
+NodeIndex FlatSymbolTable::lookupStructure(const SymbolId identifier) const {
+    const auto found = symbols.find(identifier);
+    return found != symbols.end() && found->second.kind == ASTType::Structure ? found->second.node : NO_NODE;
+}
@@ -16,43 +16,116 @@ namespace XC {
         Analyzer(const std::unique_ptr<Module>& module);
 
         static std::unique_ptr<SymbolTable> validateSemantics(const std::unique_ptr<Module>& module); 
+
+        /// Validates a module parsed into a flat tree, walking the tree itself
+        static std::unique_ptr<FlatSymbolTable> validateFlatSemantics(const std::unique_ptr<Module>& module);
     private:
         const std::unique_ptr<Module>& module;
 
-        std::unique_ptr<SymbolTable> symbol_table;
-        
+        std::unique_ptr<SymbolTable> owned_table; // nullptr in a worker, which uses its parent's
+        SymbolTable* const symbol_table;
+
+        FlatTree* const flat; // nullptr when the module was parsed into a pointer tree
+        std::unique_ptr<FlatSymbolTable> owned_flat_table; // nullptr in a worker, or when not flat
+        FlatSymbolTable* const flat_table;
+
+        // names the analyzer refers to without a token in the source
+        const SymbolId self_symbol;
+        const SymbolId bool_symbol;
+        const SymbolId int_symbol;
+        const SymbolId float_symbol;
+        const SymbolId null_symbol;
+
+        TypeCache types; // this analyzer's way into `module->types`, workers have their own
+
+        // types the analyzer derives without a declaration, from `types`
+        const DataType* const bool_type;
+        const DataType* const int_type;
+        const DataType* const float_type;
+        const DataType* const null_type;
+
+        SymbolStack symbol_stack; // reused by every function body, sized once the names above are in
+
+        // Where the walk of a flat tree is, which the scopes it pushes have no node to tell
+        NodeIndex current_function;
+        uint32_t loop_depth; // of while loops, the only ones that push a scope
+
+        std::string reports; // printed once analysis is done
         bool has_error;
 
+        struct Job;
+
+        /// Makes a worker validating functions for `parent`, on its own stack
+        /// and with its own reports
+        Analyzer(const Analyzer* parent);
+
         void checkSemantics(void);
         void loadSymbols(void);
         void validateStructures(void);
         void validateFunctions(void);
+        void validateFunctionsInParallel(const uint32_t job_count);
+
+        /// @return `false` once neither the worker's own job nor any other
+        /// has a function left, otherwise the function to validate next
+        static bool takeFunction(std::deque<Job>& jobs, Job& own, uint32_t& index);
 
         void validateStructureMember(const Structure* structure);
 
+        void validateFunction(const uint32_t index);
         void validateFunctionOwner(const Function* function);
         void validateFunctionReturnType(const Function* function);
         void validateFunctionParameters(const Function* function);
         void validateFunctionBody(const Function* function);
 
-        DataType* getTypeOfExpression(SymbolStack& symbols, Expression* expression);
+        const DataType* getTypeOfExpression(SymbolStack& symbols, Expression* expression);
 
         void validateBlockStatement(SymbolStack& stack, const BlockStatement* block);
         void validateStatement(SymbolStack& stack, const Statement* statement);
 
-        DataType* getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryExpression* expression);
-        DataType* getTypeOfPostfixExpression(SymbolStack& symbols, PostfixUnaryExpression* expression);
-        DataType* getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpression* expression);
-        DataType* getTypeOfNumberExpression(NumberConstant* number);
-        DataType* getTypeOfIdentifier(SymbolStack& symbols, IdentifierConstant* identifier);
-        DataType* getTypeOfLiteral(LiteralExpression* literal);
-        DataType* getTypeOfMemberAccess(SymbolStack& symbols, MemberAccess* member_access);
-        DataType* getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* function_call);
-
-        DataType* copyDataType(const DataType* type);
+        const DataType* getTypeOfPrefixExpression(SymbolStack& symbols, PrefixUnaryExpression* expression);
+        const DataType* getTypeOfPostfixExpression(SymbolStack& symbols, PostfixUnaryExpression* expression);
+        const DataType* getTypeOfBinaryExpression(SymbolStack& symbols, BinaryExpression* expression);
+        const DataType* getTypeOfNumberExpression(NumberConstant* number);
+        const DataType* getTypeOfIdentifier(SymbolStack& symbols, IdentifierConstant* identifier);
+        const DataType* getTypeOfLiteral(LiteralExpression* literal);
+        const DataType* getTypeOfMemberAccess(SymbolStack& symbols, MemberAccess* member_access);
+        const DataType* getTypeOfFunctionCall(SymbolStack& symbols, FunctionCall* function_call);
 
         void validateConditionalStatement(SymbolStack& symbols, const ConditionalStatement* conditional);
 
+        /// The checks of a binary operation on operands of the types given
+        /// @return the type of the operation, or nullptr with `complaint` set if it is invalid
+        const DataType* getTypeOfBinaryOperation(const TokenType operation, const std::string_view lexeme, const ASTType left_kind, const DataType* left_type, const DataType* right_type, std::string& complaint);
+
+        // <*> ========================= FLAT TREE ========================= <*>
+
+        uint32_t functionCount(void) const;
+
+        void loadFlatSymbols(void);
+        void validateFlatStructures(void);
+        void validateFlatStructureMember(const NodeIndex structure);
+
+        void validateFlatFunction(const NodeIndex index);
+        void validateFlatFunctionParameters(const FlatFunction& function);
+        void validateFlatFunctionBody(const NodeIndex index);
+
+        const DataType* getFlatType(const NodeIndex type);
+        const DataType* getTypeOfFlatExpression(SymbolStack& symbols, const NodeIndex expression);
+
+        void validateFlatBlockStatement(SymbolStack& stack, const NodeIndex block);
+        void validateFlatStatement(SymbolStack& stack, const NodeIndex statement);
+        void validateFlatConditionalStatement(SymbolStack& symbols, const NodeIndex conditional);
+
+        const DataType* getTypeOfFlatPrefixExpression(SymbolStack& symbols, const FlatExpression& expression);
+        const DataType* getTypeOfFlatPostfixExpression(SymbolStack& symbols, const FlatExpression& expression);
+        const DataType* getTypeOfFlatBinaryExpression(SymbolStack& symbols, const FlatExpression& expression);
+        const DataType* getTypeOfFlatMemberAccess(SymbolStack& symbols, const FlatExpression& member_access);
+        const DataType* getTypeOfFlatFunctionCall(SymbolStack& symbols, const FlatExpression& function_call);
+
+        /// Checks the arguments of a call to `function` against its parameters,
+        /// blaming the token `name` for a mismatch
+        const DataType* getTypeOfFlatCall(SymbolStack& symbols, const FlatFunction& function, const NodeIndex arguments, const uint32_t name);
+
         bool isIntegerType(const DataType* type);
         bool isFloatingPointType(const DataType* type);
         bool isBooleanType(const DataType* type);
@@ -65,6 +138,9 @@ namespace XC {
         void pushParametersToStack(SymbolStack& stack, const Function* function);
 
         std::nullptr_t error(const std::string& message, const Token* token);
+
+        /// Reports the error at the token of the module's stream at the index
+        std::nullptr_t errorAt(const std::string& message, const uint32_t token);
     };
 
 }
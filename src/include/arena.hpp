@@ -0,0 +1,185 @@
+/// *==============================================================*
+///  arena.hpp
+///
+///  Contains the declaration of the Arena class, a bump-pointer
+///  allocator that owns everything a module's tree is built from,
+///  and of ArenaList, the growable list stored inside of it.
+/// *==============================================================*
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include "common.hpp"
+
+#include <new>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace XC {
+
+    class Arena {
+    public:
+        Arena(void);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /// Constructs an object in the arena. Types that take an `Arena&` as
+        /// their first argument are handed this arena.
+        /// The object is never destroyed, its memory goes away with the arena.
+        template <typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(std::is_trivially_destructible_v<T>, "arena objects are released without being destroyed");
+
+            void* memory = allocate(sizeof(T), alignof(T));
+            ++objects;
+
+            if constexpr (std::is_constructible_v<T, Arena&, Args...>) {
+                return new (memory) T(*this, std::forward<Args>(args)...);
+            } else {
+                return new (memory) T(std::forward<Args>(args)...);
+            }
+        }
+
+        /// @return a copy of the text that lives as long as the arena
+        std::string_view copy(const std::string_view text);
+
+        /// @return uninitialized memory of the size, aligned to the alignment
+        void* allocate(const size_t size, const size_t alignment);
+
+        /// Grows the most recent allocation in place when the block has room
+        /// @return whether the memory at `memory` is now `size + more` bytes
+        bool extend(const void* memory, const size_t size, const size_t more);
+
+        /// Takes over the blocks of another arena, whose objects then live as
+        /// long as this one. The other arena is left empty.
+        void absorb(Arena& other);
+
+        /// Releases every block. Nothing allocated before may be used after.
+        void clear(void);
+
+        /// @return the number of objects constructed with `make`
+        uint64_t objectCount(void) const;
+
+        /// @return the number of bytes handed out, padding included
+        uint64_t bytesUsed(void) const;
+
+        /// @return the number of bytes held in blocks
+        uint64_t bytesReserved(void) const;
+
+    private:
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* cursor;
+        char* limit;
+
+        uint64_t objects;
+        uint64_t used;
+        uint64_t reserved;
+
+        void* allocateBlock(const size_t size);
+    };
+
+    /// A list whose elements live in an arena. Growing it leaves the old
+    /// elements behind in the arena unless they were the last allocation.
+    template <typename T>
+    class ArenaList {
+    public:
+        static_assert(std::is_trivially_copyable_v<T>, "arena list elements are moved by copying their bytes");
+
+        ArenaList(Arena& arena)
+            : arena(&arena),
+              items(nullptr),
+              count(0),
+              capacity(0) {}
+
+        void push_back(const T& item) {
+            if (count == capacity) {
+                grow();
+            }
+
+            items[count++] = item;
+        }
+
+        uint32_t size(void) const {
+            return count;
+        }
+
+        bool empty(void) const {
+            return count == 0;
+        }
+
+        T& at(const uint32_t index) {
+            if (index >= count) {
+                throw std::out_of_range("arena list index out of range");
+            }
+
+            return items[index];
+        }
+
+        const T& at(const uint32_t index) const {
+            if (index >= count) {
+                throw std::out_of_range("arena list index out of range");
+            }
+
+            return items[index];
+        }
+
+        T& operator[](const uint32_t index) {
+            return items[index];
+        }
+
+        const T& operator[](const uint32_t index) const {
+            return items[index];
+        }
+
+        T& back(void) {
+            return items[count - 1];
+        }
+
+        const T& back(void) const {
+            return items[count - 1];
+        }
+
+        T* begin(void) {
+            return items;
+        }
+
+        T* end(void) {
+            return items + count;
+        }
+
+        const T* begin(void) const {
+            return items;
+        }
+
+        const T* end(void) const {
+            return items + count;
+        }
+
+    private:
+        Arena* arena;
+        T* items;
+        uint32_t count;
+        uint32_t capacity;
+
+        void grow(void) {
+            const uint32_t grown = capacity == 0 ? 4 : capacity * 2;
+
+            if (items != nullptr && arena->extend(items, capacity * sizeof(T), (grown - capacity) * sizeof(T))) {
+                capacity = grown;
+                return;
+            }
+
+            T* moved = (T*) arena->allocate(grown * sizeof(T), alignof(T));
+            std::copy(items, items + count, moved);
+
+            items = moved;
+            capacity = grown;
+        }
+    };
+
+}
+
+#endif /* ARENA_HPP */
@@ -8,6 +8,7 @@
 
 #include "common.hpp"
 #include "token.hpp"
+#include "arena.hpp"
 
 namespace XC {
 
@@ -89,31 +90,46 @@ namespace XC {
         ArrayAccess
     };
 
-    using IdentifierToken = const Token;
-    using OperatorToken = const Token;
-    using NumericToken = const Token;
-    using LiteralValueToken = const Token;
+    // The tokens a node references are copies of its own, retained in the
+    // module's arena. They are not const: the reparser moves them in place
+    // when an edit shifts the text around the node.
+    using IdentifierToken = Token;
+    using OperatorToken = Token;
+    using NumericToken = Token;
+    using LiteralValueToken = Token;
 
     // <*> ================================================================ <*>
 
     struct AST {
     public:
-        virtual ~AST() = default;
-        virtual ASTType type(void) const = 0;
+        /// @return the kind of the node, stored in the node itself so
+        /// classifying one is a load rather than a virtual call
+        ASTType type(void) const {
+            return tag;
+        }
+
+    protected:
+        AST(const ASTType tag)
+            : tag(tag) {}
+
+        // Nodes live in the module's arena and are released with it,
+        // never deleted one by one
+        ~AST() = default;
+
+    private:
+        ASTType tag;
     };
 
     struct Declaration : public AST {
-    public:
-        ASTType type(void) const {
-            return ASTType::Declaration;
-        }
+    protected:
+        Declaration(const ASTType tag)
+            : AST(tag) {}
     };
 
     struct Statement : public AST {
-    public:
-        ASTType type(void) const {
-            return ASTType::Statement;
-        }
+    protected:
+        Statement(const ASTType tag)
+            : AST(tag) {}
     };
 
     struct DataType : public AST {
@@ -123,48 +139,36 @@ namespace XC {
         uint32_t dimensions;
 
         DataType(void)
-            : is_reference(false),
+            : AST(ASTType::DataType),
+              is_reference(false),
               type_name(nullptr),
               dimensions(0) {}
-
-        ASTType type(void) const {
-            return ASTType::DataType;
-        }
     };
 
     struct Expression : public AST {
     public:
-        DataType* evaluated_type;
-
-        Expression(void)
-            : evaluated_type(nullptr) {}
+        const DataType* evaluated_type; // from the module's type table
 
-        ~Expression() {
-            delete evaluated_type;
-        }
-
-        ASTType type(void) const {
-            return ASTType::Expression;
-        }
+    protected:
+        Expression(const ASTType tag)
+            : AST(tag),
+              evaluated_type(nullptr) {}
     };
 
     // <*> ================================================================ <*>
 
     struct ErrorNode : public AST {
     public:
-        std::string reason;
+        std::string_view reason; // copied into the arena
         uint32_t occurrence;
         ErrorNode* additional_errors;
 
         ErrorNode(void)
-            : reason(std::string()),
+            : AST(ASTType::ErrorNode),
+              reason(std::string_view()),
               occurrence(0),
               additional_errors(nullptr) {}
 
-        ~ErrorNode() {
-            delete additional_errors;
-        }
-
         void appendError(ErrorNode* error) {
             if (additional_errors != nullptr) {
                 ErrorNode* current = additional_errors;
@@ -178,10 +182,6 @@ namespace XC {
                 additional_errors = error;
             }
         }
-
-        ASTType type(void) const {
-            return ASTType::ErrorNode;
-        }
     };
 
     // <*> ================================================================ <*>
@@ -208,95 +208,47 @@ namespace XC {
         IdentifierToken* variable_name;
 
         VariableDeclarator(void)
-            : data_type(nullptr),
+            : AST(ASTType::VariableDeclarator),
+              data_type(nullptr),
               variable_name(nullptr) {}
-
-        ~VariableDeclarator() {
-            delete data_type; 
-        }
-
-        ASTType type(void) const {
-            return ASTType::VariableDeclarator;
-        }
     };
 
     struct StructureMembers : public AST {
     public:
-        std::vector<VariableDeclarator*> members;
+        ArenaList<VariableDeclarator*> members;
 
-        StructureMembers(void)
-            : members(std::vector<VariableDeclarator*>()){}
-
-        ~StructureMembers() {
-            for (VariableDeclarator*& member : members) {
-                delete member;
-                member = nullptr;
-            }
-        }
-
-        ASTType type(void) const {
-            return ASTType::StructureMembers;
-        }
+        StructureMembers(Arena& arena)
+            : AST(ASTType::StructureMembers),
+              members(arena){}
     };
 
     struct ParameterList : public AST {
     public:
-        std::vector<VariableDeclarator*> parameters;
-
-        ParameterList(void)
-            : parameters(std::vector<VariableDeclarator*>()) {}
+        ArenaList<VariableDeclarator*> parameters;
 
-        ~ParameterList() {
-            for (VariableDeclarator*& declarator : parameters) {
-                delete declarator;
-                declarator = nullptr;
-            }
-        }
-
-        ASTType type(void) const {
-            return ASTType::ParameterList;
-        }
+        ParameterList(Arena& arena)
+            : AST(ASTType::ParameterList),
+              parameters(arena) {}
     };
 
     struct BlockStatement : public AST {
     public:
-        std::vector<Statement*> statements;
-
-        BlockStatement(void)
-            : statements(std::vector<Statement*>()) {}
-
+        ArenaList<Statement*> statements;
 
-        ~BlockStatement() {
-            for (Statement*& statement : statements) {
-                delete statement;
-                statement = nullptr;
-            }
-        }
-
-        ASTType type(void) const {
-            return ASTType::BlockStatement;
-        }
+        BlockStatement(Arena& arena)
+            : AST(ASTType::BlockStatement),
+              statements(arena) {}
     };
 
     // <*> ================================================================ <*>
 
     struct Program : public AST {
     public:
-        std::vector<Declaration*> declarations;
+        ArenaList<Declaration*> declarations;
 
-        Program(void)
-            : declarations(std::vector<Declaration*>()) {}
-
-        ~Program() {
-            for (Declaration*& declaration : declarations) {
-                delete declaration;
-                declaration = nullptr;
-            }
-        }
-
-        ASTType type(void) const {
-            return ASTType::Program;
-        }
+        Program(Arena& arena)
+            : AST(ASTType::Program),
+              declarations(arena) {}
     };
 
     struct Function : public Declaration {
@@ -308,21 +260,12 @@ namespace XC {
         BlockStatement* body;
 
         Function(void)
-            : owner(nullptr),
+            : Declaration(ASTType::Function),
+              owner(nullptr),
               return_type(nullptr),
               name(nullptr),
               parameters(nullptr),
               body(nullptr) {}
-
-        ~Function() {
-            delete return_type;
-            delete parameters;
-            delete body;
-        }
-
-        ASTType type(void) const {
-            return ASTType::Function;
-        }
     };
 
     struct Structure : public Declaration {
@@ -331,16 +274,9 @@ namespace XC {
         StructureMembers* members;
 
         Structure(void)
-            : name(nullptr),
+            : Declaration(ASTType::Structure),
+              name(nullptr),
               members(nullptr) {}
-
-        ~Structure() {
-            delete members;
-        }
-
-        ASTType type(void) const {
-            return ASTType::Structure;
-        }
     };
 
     // <*> ================================================================ <*>
@@ -350,15 +286,8 @@ namespace XC {
         Expression* expression;
 
         ExpressionStatement(void)
-            : expression(nullptr) {}
-
-        ~ExpressionStatement() {
-            delete expression;
-        }
-
-        ASTType type(void) const {
-            return ASTType::ExpressionStatement;
-        }
+            : Statement(ASTType::ExpressionStatement),
+              expression(nullptr) {}
     };
 
     struct ConditionalStatement : public Statement {
@@ -368,19 +297,10 @@ namespace XC {
         ConditionalStatement* else_case;
 
         ConditionalStatement(void)
-            : condition(nullptr),
+            : Statement(ASTType::ConditionalStatement),
+              condition(nullptr),
               body(nullptr),
               else_case(nullptr) {}
-
-        ~ConditionalStatement() {
-            delete condition;
-            delete body;
-            delete else_case;
-        } 
-
-        ASTType type(void) const {
-            return ASTType::ConditionalStatement;
-        }
     };
 
     struct VariableDeclarationStatement : public Statement {
@@ -389,17 +309,9 @@ namespace XC {
         Expression* initial;
 
         VariableDeclarationStatement(void)
-            : declarator(nullptr),
+            : Statement(ASTType::VariableDeclarationStatement),
+              declarator(nullptr),
               initial(nullptr) {}
-
-        ~VariableDeclarationStatement() {
-            delete declarator;
-            delete initial;
-        }
-
-        ASTType type(void) const {
-            return ASTType::VariableDeclarationStatement;
-        }
     };
 
     struct WhileIteration : public Statement {
@@ -408,12 +320,9 @@ namespace XC {
         BlockStatement* body;
 
         WhileIteration(void)
-            : condition(nullptr),
+            : Statement(ASTType::WhileIteration),
+              condition(nullptr),
               body(nullptr) {}
-
-        ASTType type(void) const {
-            return ASTType::WhileIteration;
-        }
     };
 
     struct ForIteration : public Statement {
@@ -424,21 +333,11 @@ namespace XC {
         BlockStatement* body;
 
         ForIteration(void)
-            : initial(nullptr),
+            : Statement(ASTType::ForIteration),
+              initial(nullptr),
               condition(nullptr),
               update(nullptr),
               body(nullptr) {}
-
-        ~ForIteration() {
-            delete initial;
-            delete condition;
-            delete update;
-            delete body;
-        }
-
-        ASTType type(void) const {
-            return ASTType::ForIteration;
-        }
     };
 
     struct ReturnStatement : public Statement {
@@ -446,50 +345,31 @@ namespace XC {
         Expression* expression;
 
         ReturnStatement(void)
-            : expression(nullptr) {}
-
-        ~ReturnStatement() {
-            delete expression;
-        }
-
-        ASTType type(void) const {
-            return ASTType::ReturnStatement;
-        }
+            : Statement(ASTType::ReturnStatement),
+              expression(nullptr) {}
     };
 
     struct ContinueStatement : public Statement {
     public:
-        ASTType type(void) const {
-            return ASTType::ContinueStatement;
-        }
+        ContinueStatement(void)
+            : Statement(ASTType::ContinueStatement) {}
     };
 
     struct BreakStatement : public Statement {
     public:
-        ASTType type(void) const {
-            return ASTType::BreakStatement;
-        }
+        BreakStatement(void)
+            : Statement(ASTType::BreakStatement) {}
     };
 
     // <*> ================================================================ <*>
 
     struct ExpressionList : public AST {
     public:
-        std::vector<Expression*> expressions;
-
-        ExpressionList(void)
-            : expressions(std::vector<Expression*>()) {}
-
-        ~ExpressionList() {
-            for (Expression*& expression : expressions) {
-                delete expression;
-                expression = nullptr;
-            }
-        }
+        ArenaList<Expression*> expressions;
 
-        ASTType type(void) const {
-            return ASTType::ExpressionList;
-        }
+        ExpressionList(Arena& arena)
+            : AST(ASTType::ExpressionList),
+              expressions(arena) {}
     };
 
     struct PrefixUnaryExpression : public Expression {
@@ -498,16 +378,9 @@ namespace XC {
         Expression* operand;
 
         PrefixUnaryExpression(void)
-            : operation(nullptr),
+            : Expression(ASTType::PrefixUnaryExpression),
+              operation(nullptr),
               operand(nullptr) {}
-
-        ~PrefixUnaryExpression() {
-            delete operand;
-        }
-
-        ASTType type(void) const {
-            return ASTType::PrefixUnaryExpression;
-        }
     };
 
     struct PostfixUnaryExpression : public Expression {
@@ -516,16 +389,9 @@ namespace XC {
         Expression* operand;
 
         PostfixUnaryExpression(void)
-            : operation(nullptr),
+            : Expression(ASTType::PostfixUnaryExpression),
+              operation(nullptr),
               operand(nullptr) {}
-
-        ~PostfixUnaryExpression() {
-            delete operand;
-        }
-
-        ASTType type(void) const {
-            return ASTType::PostfixUnaryExpression;
-        }
     };
 
     struct BinaryExpression : public Expression {
@@ -535,18 +401,10 @@ namespace XC {
         Expression* right_operand;
 
         BinaryExpression(void)
-            : operation(nullptr),
+            : Expression(ASTType::BinaryExpression),
+              operation(nullptr),
               left_operand(nullptr),
               right_operand(nullptr) {}
-
-        ~BinaryExpression() {
-            delete left_operand;
-            delete right_operand;
-        }
-
-        ASTType type(void) const {
-            return ASTType::BinaryExpression;
-        }
     };
 
     // <*> ================================================================ <*>
@@ -556,11 +414,8 @@ namespace XC {
         LiteralValueToken* value;
 
         LiteralExpression(void)
-            : value(nullptr) {}
-
-        ASTType type(void) const {
-            return ASTType::LiteralExpression;
-        }
+            : Expression(ASTType::LiteralExpression),
+              value(nullptr) {}
     };
 
     struct NumberConstant : Expression {
@@ -568,11 +423,8 @@ namespace XC {
         NumericToken* value;
 
         NumberConstant(void)
-            : value(nullptr) {}
-
-        ASTType type(void) const {
-            return ASTType::NumberConstant;
-        }
+            : Expression(ASTType::NumberConstant),
+              value(nullptr) {}
     };
 
     struct IdentifierConstant : Expression {
@@ -580,11 +432,8 @@ namespace XC {
         IdentifierToken* value;
 
         IdentifierConstant(void)
-            : value(nullptr) {}
-
-        ASTType type(void) const {
-            return ASTType::IdentifierConstant;
-        }
+            : Expression(ASTType::IdentifierConstant),
+              value(nullptr) {}
     };
 
     struct MemberAccess : public Expression {
@@ -593,16 +442,9 @@ namespace XC {
         IdentifierToken* member;
 
         MemberAccess(void)
-            : owner(nullptr),
+            : Expression(ASTType::MemberAccess),
+              owner(nullptr),
               member(nullptr) {}
-
-        ~MemberAccess() {
-            delete owner;
-        }
-
-        ASTType type(void) const {
-            return ASTType::MemberAccess;
-        }
     };
 
     struct FunctionCall : public Expression {
@@ -611,17 +453,9 @@ namespace XC {
         ExpressionList* arguments;
 
         FunctionCall(void)
-            : function(nullptr),
+            : Expression(ASTType::FunctionCall),
+              function(nullptr),
               arguments(nullptr) {}
-
-        ~FunctionCall() {
-            delete function;
-            delete arguments;
-        }
-
-        ASTType type(void) const {
-            return ASTType::FunctionCall;
-        }
     };
 
     struct ArrayAccess : public Expression {
@@ -630,17 +464,9 @@ namespace XC {
         Expression* index;
 
         ArrayAccess(void)
-            : array(nullptr),
+            : Expression(ASTType::ArrayAccess),
+              array(nullptr),
               index(nullptr) {}
-
-        ~ArrayAccess() {
-            delete array;
-            delete index;
-        }
-
-        ASTType type(void) const {
-            return ASTType::ArrayAccess;
-        }
     };
 
     struct CastExpression : public Expression {
@@ -649,24 +475,16 @@ namespace XC {
         Expression* expression;
 
         CastExpression(void)
-            : data_type(nullptr),
+            : Expression(ASTType::CastExpression),
+              data_type(nullptr),
               expression(nullptr) {}
-
-        ~CastExpression() {
-            delete data_type;
-            delete expression;
-        }
-
-        ASTType type(void) const {
-            return ASTType::CastExpression;
-        }
     };
 
     // <*> ================================================================ <*>
 
-    Expression* newBinaryExpression(OperatorToken* _operator, Expression* left_operand, Expression* right_operand);
-    Expression* newPrefixExpression(OperatorToken* _operator, Expression* operand);
-    Expression* newPostfixExpression(OperatorToken* _operator, Expression* operand);
+    Expression* newBinaryExpression(Arena& arena, OperatorToken* _operator, Expression* left_operand, Expression* right_operand);
+    Expression* newPrefixExpression(Arena& arena, OperatorToken* _operator, Expression* operand);
+    Expression* newPostfixExpression(Arena& arena, OperatorToken* _operator, Expression* operand);
 
     // <*> ================================================================ <*>
 
@@ -0,0 +1,61 @@
+/// *==============================================================*
+///  cache.hpp
+///
+///  Contains the declaration of the Cache class, which saves the
+///  names, tokens and syntax tree of a module to disk and loads
+///  them back when the same source is compiled again.
+/// *==============================================================*
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include "common.hpp"
+#include "xc.hpp"
+
+namespace XC {
+
+    /// @return the hash with one more word mixed into it
+    inline uint64_t mixHash(uint64_t hash, const uint64_t word) {
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 29);
+    }
+
+    /// @return the hash with the bytes of the content mixed into it
+    uint64_t hashContent(const std::string_view content, uint64_t hash);
+
+    /// @return a key standing for the compiler binary and the format of what
+    /// it writes to disk, or 0 if the binary cannot be told apart
+    uint64_t compilerKey(const uint32_t format);
+
+    class Cache {
+    public:
+        /// Locates the entry of the module's source in the cache directory.
+        /// Entries are keyed by the source contents and the compiler binary,
+        /// so rebuilding the compiler misses every entry made before.
+        Cache(const std::unique_ptr<Module>& module);
+
+        /// Restores the names, token stream and tree of the module from its
+        /// entry, mapping the file once. Damaged entries count as a miss.
+        /// @return `true` if there was an entry to restore
+        bool load(void);
+
+        /// Writes the names, token stream and tree of a parsed module to its
+        /// entry. Failing to is not an error, the next compile just misses.
+        /// @return `true` if the entry was written
+        bool store(void);
+
+        /// @return `false` if no cache directory was given
+        bool isEnabled(void) const;
+
+    private:
+        const std::unique_ptr<Module>& module;
+
+        uint64_t key;
+        std::string path; // empty -> caching disabled
+
+        struct Writer;
+        struct Reader;
+    };
+
+}
+
+#endif /* CACHE_HPP */
@@ -12,31 +12,107 @@
 
 #include "common.hpp"
 
+#include <array>
+
+namespace CharacterClass {
+
+    enum : uint8_t {
+        LETTER = 1 << 0,
+        DIGIT = 1 << 1,
+        BINARY_DIGIT = 1 << 2,
+        OCTAL_DIGIT = 1 << 3,
+        HEXADECIMAL_DIGIT = 1 << 4,
+        WHITESPACE = 1 << 5,
+        SYMBOL = 1 << 6,
+        UNDERSCORE = 1 << 7,
+
+        IDENTIFIER = LETTER | DIGIT | UNDERSCORE,
+        RECOGNIZED = LETTER | DIGIT | WHITESPACE | SYMBOL | UNDERSCORE
+    };
+
+    constexpr std::array<uint8_t, 256> build(void) {
+        std::array<uint8_t, 256> table = {};
+
+        for (int c = 'a'; c <= 'z'; ++c) table[c] |= LETTER;
+        for (int c = 'A'; c <= 'Z'; ++c) table[c] |= LETTER;
+
+        for (int c = '0'; c <= '9'; ++c) table[c] |= DIGIT | HEXADECIMAL_DIGIT;
+        for (int c = '0'; c <= '7'; ++c) table[c] |= OCTAL_DIGIT;
+        for (int c = '0'; c <= '1'; ++c) table[c] |= BINARY_DIGIT;
+        for (int c = 'a'; c <= 'f'; ++c) table[c] |= HEXADECIMAL_DIGIT;
+        for (int c = 'A'; c <= 'F'; ++c) table[c] |= HEXADECIMAL_DIGIT;
+
+        for (const char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+            table[(uint8_t) c] |= WHITESPACE;
+        }
+
+        for (const char c : {'(', ')', '[', ']', '{', '}', ';', ':', ',', '.', '=', '~', '+', '-', '*', '/', '%', '&', '^', '|', '<', '>', '!', '\''}) {
+            table[(uint8_t) c] |= SYMBOL;
+        }
+
+        table['_'] |= UNDERSCORE;
+
+        return table;
+    }
+
+    /// Classes of every byte, indexed by the byte's unsigned value
+    inline constexpr std::array<uint8_t, 256> table = build();
+
+    /// @return `true` if the character belongs to any of the given classes
+    constexpr bool is(const char c, const uint8_t classes) {
+        return (table[(uint8_t) c] & classes) != 0;
+    }
+
+}
+
 /// @return `true` if the character is a letter (A-Z, or a-z)
-bool isLetter(const char c);
+constexpr bool isLetter(const char c) {
+    return CharacterClass::is(c, CharacterClass::LETTER);
+}
 
 /// @return `true` if the character is a digit (0-9)
-bool isDigit(const char c);
+constexpr bool isDigit(const char c) {
+    return CharacterClass::is(c, CharacterClass::DIGIT);
+}
 
 /// @return `true` if the character is either a letter or a digit
-bool isLetterOrDigit(const char c);
+constexpr bool isLetterOrDigit(const char c) {
+    return CharacterClass::is(c, CharacterClass::LETTER | CharacterClass::DIGIT);
+}
 
 /// @return `true` if the character is a hexadecimal digit (0-9, A-F, or a-f)
-bool isHexadecimalDigit(const char c);
+constexpr bool isHexadecimalDigit(const char c) {
+    return CharacterClass::is(c, CharacterClass::HEXADECIMAL_DIGIT);
+}
 
 /// @return `true` if the character is a binary digit (0-1)
-bool isBinaryDigit(const char c);
+constexpr bool isBinaryDigit(const char c) {
+    return CharacterClass::is(c, CharacterClass::BINARY_DIGIT);
+}
 
 /// @return `true` if the character is an octal digit (0-7)
-bool isOctalDigit(const char c);
+constexpr bool isOctalDigit(const char c) {
+    return CharacterClass::is(c, CharacterClass::OCTAL_DIGIT);
+}
 
 /// @return `true` if the character is a whitespace character (e.g., space, tab)
-bool isWhitespace(const char c);
+constexpr bool isWhitespace(const char c) {
+    return CharacterClass::is(c, CharacterClass::WHITESPACE);
+}
 
 /// @return `true` if the character is a symbol defined within the XC language specification
-bool isSymbol(const char c);
+constexpr bool isSymbol(const char c) {
+    return CharacterClass::is(c, CharacterClass::SYMBOL);
+}
+
+/// @return `true` if the character can appear in an identifier (letter, digit, or `_`)
+constexpr bool isIdentifierCharacter(const char c) {
+    return CharacterClass::is(c, CharacterClass::IDENTIFIER);
+}
 
 /// @return `true` if the character is recognized by the XC language specification
-bool isRecognized(const char c);
+constexpr bool isRecognized(const char c) {
+    return CharacterClass::is(c, CharacterClass::RECOGNIZED);
+}
 
 #endif /* CCLASS_HPP */
\ No newline at end of file
@@ -46,6 +46,27 @@ namespace XC {
         std::string translateFunctionSignature(const Function* function);
         std::string translateExpression(const Expression* expression);
         std::string translateVariableDeclaration(const VariableDeclarationStatement* declaration);
+
+        std::string translateType(const TokenType type_name, const std::string_view name, const bool is_reference);
+        std::string translatePrefixOperator(const TokenType operation);
+        std::string translatePostfixOperator(const TokenType operation);
+        std::string translateBinaryOperator(const TokenType operation);
+        std::string translateConstant(const TokenType type, const std::string_view value); // of a literal or number
+
+        // <*> ========================= FLAT TREE ========================= <*>
+
+        void generateFlatStructureDeclaration(void);
+        void generateFlatFunctionDeclaration(void);
+        void generateFlatStructureImplementation(void);
+        void generateFlatFunctionImplementation(void);
+
+        void generateFlatBlockStatement(const NodeIndex block);
+        void generateFlatStatement(const NodeIndex statement);
+
+        std::string translateFlatDataType(const NodeIndex type);
+        std::string translateFlatFunctionSignature(const NodeIndex function);
+        std::string translateFlatExpression(const NodeIndex expression);
+        std::string translateFlatVariableDeclaration(const NodeIndex declaration);
     };
 
 }
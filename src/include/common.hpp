@@ -12,11 +12,13 @@
 #include <cstdlib>
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <memory>
 #include <fstream>
 
 #include <stack>
+#include <deque>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -0,0 +1,92 @@
+/// *==============================================================*
+///  fingerprints.hpp
+///
+///  Contains the declaration of the Fingerprints class, which keeps
+///  the functions a compile found valid, with the code generated
+///  for them, next to the output, so the next compile can skip
+///  analyzing and generating those that did not change.
+/// *==============================================================*
+#ifndef FINGERPRINTS_HPP
+#define FINGERPRINTS_HPP
+
+#include "common.hpp"
+#include "interner.hpp"
+#include "token.hpp"
+#include "ast.hpp"
+#include "symboltable.hpp"
+
+namespace XC {
+
+    struct Module;
+
+    class Fingerprints {
+    public:
+        /// Loads the record the last compile of the module left, and works
+        /// out the signatures of the functions loaded into `symbols`. A
+        /// damaged record, or one from another compiler, is ignored.
+        Fingerprints(const std::unique_ptr<Module>& module, SymbolTable& symbols);
+
+        /// Different functions may be asked about at once.
+        /// @return `true` if neither the function nor a declaration it refers
+        /// to changed since a compile it was valid in, so it needs not be
+        /// analyzed or generated again
+        bool reuse(const uint32_t index);
+
+        /// Marks the function as valid. It must have been asked to be reused first.
+        void validated(const uint32_t index);
+
+        /// @return the code generated for the function by the compile it is
+        /// reused from, or nothing if it is not reused
+        std::string_view reusedCode(const uint32_t index) const;
+
+        /// Keeps the code generated for a valid function, to be recorded
+        void generated(const uint32_t index, const std::string_view code);
+
+        /// Writes the record of the functions found valid, unless the file
+        /// already holds it
+        /// @return `true` if the file was written
+        bool store(void);
+
+        /// @return the number of functions reused
+        uint32_t reusedCount(void) const;
+
+    private:
+        const std::unique_ptr<Module>& module;
+        SymbolTable& symbols;
+
+        std::string path; // empty -> nothing is kept, the compiler cannot be told apart or the tokens were streamed
+        uint64_t key;
+
+        // A function is fingerprinted by its tokens, which it parses the same
+        // from every time, the structures and the signatures it names
+        uint64_t structures_hash;
+        std::unordered_map<SymbolId, uint64_t> signatures; // by the name of the function
+        std::vector<uint64_t> names; // by symbol, the hash of the name
+        std::vector<uint64_t> meanings; // by symbol, the hash of the name and of what it names
+
+        struct Record {
+        public:
+            uint32_t first_token; // spanning [first_token, last_token)
+            uint32_t last_token;
+            uint64_t fingerprint;
+            bool valid;
+            bool reused;
+            std::string_view previous_code; // in `previous`, when reused
+            std::string code; // when generated
+        };
+
+        std::vector<Record> records; // by index into the functions of `symbols`
+
+        // The record of the last compile, as read
+        std::string previous;
+        std::unordered_map<uint64_t, std::string_view> previous_functions; // fingerprint -> code
+
+        bool locateDeclarations(void);
+        void load(void);
+
+        uint64_t hash(uint32_t first, const uint32_t last, uint64_t hash, const bool with_dependency) const;
+    };
+
+}
+
+#endif /* FINGERPRINTS_HPP */
@@ -0,0 +1,176 @@
+/// *==============================================================*
+///  flattree.hpp
+///
+///  Contains the declaration of the FlatTree class, the syntax tree
+///  laid out as one contiguous array per kind of node, where nodes
+///  refer to each other and to their tokens by 32-bit indices, and
+///  of FlatSymbolTable, which finds its declarations by name.
+/// *==============================================================*
+#ifndef FLATTREE_HPP
+#define FLATTREE_HPP
+
+#include "common.hpp"
+#include "token.hpp"
+#include "ast.hpp"
+#include "interner.hpp"
+
+namespace XC {
+
+    /// The index of a node in the array of its kind
+    using NodeIndex = uint32_t;
+
+    static constexpr NodeIndex NO_NODE = UINT32_MAX;
+    static constexpr uint32_t NO_TOKEN = UINT32_MAX;
+
+    // Tokens are indices into the module's token stream
+
+    struct FlatType {
+    public:
+        uint32_t type_name; // token
+        uint32_t dimensions;
+        bool is_reference;
+    };
+
+    struct FlatDeclarator {
+    public:
+        NodeIndex data_type;
+        uint32_t variable_name; // token
+    };
+
+    struct FlatFunction {
+    public:
+        uint32_t owner; // token, NO_TOKEN -> no owner
+        NodeIndex return_type; // NO_NODE -> void
+        uint32_t name; // token
+        NodeIndex parameters; // list of declarators, NO_NODE -> none
+        NodeIndex body; // list of statements
+    };
+
+    struct FlatStructure {
+    public:
+        uint32_t name; // token
+        NodeIndex members; // list of declarators
+    };
+
+    struct FlatStatement {
+    public:
+        ASTType kind;
+        NodeIndex expression; // the initial value, condition or value returned
+        NodeIndex update; // of a for
+        NodeIndex body; // list of statements, of a loop, conditional or else block
+        NodeIndex nested; // the declarator of a declaration, the initial declaration of a for, or the else case of a conditional
+    };
+
+    struct FlatExpression {
+    public:
+        ASTType kind;
+        uint32_t token; // the operator, the value, or the member accessed
+        NodeIndex left; // the operand, left operand, owner, function called or array
+        NodeIndex right; // the right operand, the index, or the list of arguments of a call
+    };
+
+    struct FlatDeclaration {
+    public:
+        ASTType kind; // Function or Structure
+        NodeIndex node;
+    };
+
+    /// A run of `children`
+    struct FlatList {
+    public:
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// The elements of a list, to iterate over
+    struct FlatChildren {
+    public:
+        const NodeIndex* first;
+        const NodeIndex* last;
+
+        const NodeIndex* begin(void) const {
+            return first;
+        }
+
+        const NodeIndex* end(void) const {
+            return last;
+        }
+
+        uint32_t size(void) const {
+            return last - first;
+        }
+
+        NodeIndex operator[](const uint32_t index) const {
+            return first[index];
+        }
+    };
+
+    class FlatTree {
+    public:
+        std::vector<FlatDeclaration> declarations; // in the order of the source
+        std::vector<FlatFunction> functions;
+        std::vector<FlatStructure> structures;
+        std::vector<FlatDeclarator> declarators;
+        std::vector<FlatType> types;
+        std::vector<FlatStatement> statements;
+        std::vector<FlatExpression> expressions;
+        std::vector<FlatList> lists; // parameters, members, statements of a block and arguments of a call
+        std::vector<NodeIndex> children; // of the lists, every list in one run
+
+        std::vector<const DataType*> evaluated_types; // by expression, from the module's type table
+
+        FlatTree(void);
+
+        /// Copies a declaration of the pointer tree to the end of this one.
+        /// Nothing of it is referenced afterwards.
+        void append(const Declaration* declaration);
+
+        FlatChildren childrenOf(const NodeIndex list) const;
+
+        /// @return the number of nodes in every array
+        uint64_t nodeCount(void) const;
+
+        /// @return the number of bytes the nodes take
+        uint64_t bytesUsed(void) const;
+
+        /// @return the number of bytes the arrays hold, grown ahead of the nodes
+        uint64_t bytesReserved(void) const;
+
+    private:
+        NodeIndex appendType(const DataType* type);
+        NodeIndex appendDeclarator(const VariableDeclarator* declarator);
+        NodeIndex appendBlock(const BlockStatement* block);
+        NodeIndex appendStatement(const Statement* statement);
+        NodeIndex appendExpression(const Expression* expression);
+
+        /// @return a list of `count` children, filled in by the caller
+        NodeIndex appendList(const uint32_t count);
+    };
+
+    /// The declarations of a flat tree by name, as the SymbolTable holds
+    /// those of a pointer tree
+    struct FlatSymbolTable {
+    public:
+        FlatSymbolTable(void);
+
+        /// @return every function loaded, in the order they were loaded in,
+        /// which is the order of the source
+        const std::vector<NodeIndex>& getAllFunctions(void) const;
+        const std::vector<NodeIndex>& getAllStructures(void) const;
+
+        bool loadFunction(const SymbolId name, const NodeIndex function);
+        bool loadStructure(const SymbolId name, const NodeIndex structure);
+
+        /// @return NO_NODE if no function or structure has the name
+        NodeIndex lookupFunction(const SymbolId identifier) const;
+        NodeIndex lookupStructure(const SymbolId identifier) const;
+
+    private:
+        std::unordered_map<SymbolId, FlatDeclaration> symbols;
+        std::vector<NodeIndex> functions;
+        std::vector<NodeIndex> structures;
+    };
+
+}
+
+#endif /* FLATTREE_HPP */
@@ -0,0 +1,43 @@
+/// *==============================================================*
+///  interner.hpp
+///
+///  Contains the declaration of the Interner class, which maps
+///  every distinct name in a module to a small integer.
+/// *==============================================================*
+#ifndef INTERNER_HPP
+#define INTERNER_HPP
+
+#include "common.hpp"
+
+namespace XC {
+
+    using SymbolId = uint32_t;
+
+    static constexpr SymbolId NO_SYMBOL = UINT32_MAX;
+
+    class Interner {
+    public:
+        Interner(void);
+
+        /// @return the id of the name, assigning the next one if it is new.
+        /// The name is not copied, it must outlive the interner.
+        SymbolId intern(const std::string_view name);
+
+        /// @return the name the id was assigned to
+        std::string_view name(const SymbolId id) const;
+
+        /// Points the id at another copy of its name, for when the text the
+        /// name was viewed from is about to go away
+        void rebind(const SymbolId id, const std::string_view name);
+
+        /// @return the number of distinct names interned
+        uint32_t size(void) const;
+
+    private:
+        std::unordered_map<std::string_view, SymbolId> ids;
+        std::vector<std::string_view> names;
+    };
+
+}
+
+#endif /* INTERNER_HPP */
@@ -0,0 +1,65 @@
+/// *==============================================================*
+///  layout.hpp
+///
+///  Contains the declaration of the LayoutTable class, which works
+///  out the size, alignment and padding the C compiler gives every
+///  structure of a module, and the member order that wastes the
+///  least space to padding.
+/// *==============================================================*
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+
+#include "common.hpp"
+#include "ast.hpp"
+#include "symboltable.hpp"
+
+namespace XC {
+
+    struct StructureLayout {
+    public:
+        bool is_known; // false when a member is of an undefined type, or holds the structure by value
+
+        uint32_t alignment;
+
+        // With the members in the order they are declared in
+        uint32_t size;
+        uint32_t padding;
+
+        // With the members, and those of the structures held by value, reordered
+        uint32_t packed_size;
+        uint32_t packed_padding;
+
+        /// The indices of the members in the order that needs the least
+        /// padding, which is the declaration order unless it saves space
+        std::vector<uint32_t> packed_order;
+    };
+
+    class LayoutTable {
+    public:
+        /// Lays out every structure loaded into `symbols`, as they are
+        /// declared in the generated C
+        LayoutTable(SymbolTable& symbols);
+
+        /// @return the layout of the structure at the index into the
+        /// structures of the symbol table
+        const StructureLayout& layoutOf(const uint32_t index) const;
+
+        static std::unique_ptr<LayoutTable> computeLayouts(SymbolTable& symbols);
+
+    private:
+        SymbolTable& symbols;
+
+        std::vector<StructureLayout> layouts; // by index into the structures of `symbols`
+        std::vector<uint8_t> states; // by index, whether the layout is not started, started or done
+        std::unordered_map<const Structure*, uint32_t> indices;
+
+        const StructureLayout& layOut(const uint32_t index);
+
+        /// Works out how much space a member of the type takes
+        /// @return `false` if it cannot be known
+        bool measure(const DataType* type, uint32_t& size, uint32_t& packed_size, uint32_t& alignment);
+    };
+
+}
+
+#endif /* LAYOUT_HPP */
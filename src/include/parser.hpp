@@ -11,27 +11,65 @@
 #include "token.hpp"
 #include "sourcefile.hpp"
 #include "ast.hpp"
+#include "tokensource.hpp"
 
 namespace XC {
 
+    /// Binding power of the binary operators, from loosest to tightest
+    enum class Precedence : uint8_t {
+        NONE,
+        ASSIGNMENT,
+        BOOLEAN_OR,
+        BOOLEAN_XOR,
+        BOOLEAN_AND,
+        BITWISE_OR,
+        BITWISE_XOR,
+        BITWISE_AND,
+        EQUALITY,
+        RELATIONAL,
+        BITWISE_SHIFT,
+        ADDITIVE,
+        MULTIPLICATIVE
+    };
+
     class Parser {
     public:
         Parser(const std::unique_ptr<Module>& module);
 
-        static std::unique_ptr<Program> getProgramTree(const std::unique_ptr<Module>& module);
+        static Program* getProgramTree(const std::unique_ptr<Module>& module);
+
+        /// Parses the module into a flat tree, one declaration at a time, so
+        /// the pointer tree of no more than one declaration is held at once
+        static std::unique_ptr<FlatTree> getFlatTree(const std::unique_ptr<Module>& module);
+
+        // Relexes and reparses the parts of a module an edit touches
+        friend class Reparser;
     private:
         const std::unique_ptr<Module>& module;
+        Arena& arena; // the module's, or a chunk's own when parsing in parallel
 
         uint32_t position;
-        std::unique_ptr<Program> program;
+        TokenSource tokens;
+        Program* program; // allocated in `arena`
+        FlatTree* flat; // nullptr -> the declarations are kept in `program`
+        std::string reports; // printed once parsing is done
         bool has_error;
 
-        void parse(void);
+        struct Chunk;
+
+        Parser(const std::unique_ptr<Module>& module, Arena& arena);
+
+        void parseInParallel(const uint32_t chunk_count);
+
+        /// Parses declarations until the end of the source, or until one
+        /// ends at or after `limit`
+        void parse(const uint32_t limit);
         bool atEnd(void);
 
-        const Token& current(void);
-        const Token& next(void);
-        const Token& peek(void);
+        Token current(void);
+        Token next(void);
+        Token peek(void);
+        void skip(void);
 
         bool match(const TokenType expect);
         bool matchNext(const TokenType expect);
@@ -50,6 +88,7 @@ namespace XC {
         AST* parseBlockStatement(void);
 
         AST* parseStatement(void);
+        bool startsVariableDeclaration(void);
         AST* parseExpressionStatement(void);
         AST* parseVariableDeclarationStatement(void);
         AST* parseWhileIteration(void);
@@ -63,18 +102,7 @@ namespace XC {
         AST* parseVariableDeclarator(void);
 
         AST* parseExpression(void);
-        AST* parseAssignment(void);
-        AST* parseBooleanOR(void);
-        AST* parseBooleanXOR(void);
-        AST* parseBooleanAND(void);
-        AST* parseBitwiseOR(void);
-        AST* parseBitwiseXOR(void);
-        AST* parseBitwiseAND(void);
-        AST* parseEquality(void);
-        AST* parseRelational(void);
-        AST* parseBitwiseShift(void);
-        AST* parseAdditive(void);
-        AST* parseMultiplicative(void);
+        AST* parseBinary(const Precedence minimum);
         AST* parsePrefix(void);
         AST* parsePostfix(void);
         AST* parsePrimary(void);
@@ -92,7 +120,9 @@ namespace XC {
 
         using ProductionRule = AST* (XC::Parser::*)(void);
 
-        AST* tryParse(const std::vector<ProductionRule>& rules, const std::string& error_message);
+        /// Parses the construct the lookahead picked, resuming at its first
+        /// error if it fails. Failing on its first token is reported as `error_message`.
+        AST* parsePredicted(const ProductionRule rule, const std::string& error_message);
     };
 
 }
@@ -0,0 +1,70 @@
+/// *==============================================================*
+///  reparser.hpp
+///
+///  Contains the declaration for the Reparser class, which applies
+///  a text edit to a parsed module by relexing and reparsing only
+///  the top-level declarations the edit touches.
+/// *==============================================================*
+#ifndef REPARSER_HPP
+#define REPARSER_HPP
+
+#include "common.hpp"
+#include "xc.hpp"
+#include "sourcefile.hpp"
+#include "token.hpp"
+#include "ast.hpp"
+
+namespace XC {
+
+    /// Replaces the bytes in [begin, end) of a source with `replacement`
+    struct Edit {
+    public:
+        uint32_t begin;
+        uint32_t end;
+        std::string_view replacement;
+
+        /// @return the smallest edit turning `before` into `after`, the text
+        /// between their common prefix and suffix
+        static Edit between(const std::string_view before, const std::string_view after);
+    };
+
+    class Reparser {
+    public:
+        /// Applies the edit to the module's source and brings its tokens and
+        /// tree up to date. Declarations the edit does not touch are kept,
+        /// tokens and all, and only have their positions moved. The symbols
+        /// are dropped, they have to be validated again.
+        /// @return `false` if the edited source has errors, which were reported
+        static bool applyEdit(const std::unique_ptr<Module>& module, const Edit& edit);
+
+    private:
+        const std::unique_ptr<Module>& module;
+        const Edit& edit;
+
+        std::unique_ptr<SourceFile> previous_source; // viewed by the kept tokens until they are moved
+        std::unique_ptr<TokenStream> previous_tokens;
+
+        int64_t byte_shift; // how far the text after the edit moved
+        int64_t token_shift;
+        int64_t line_shift;
+
+        Reparser(const std::unique_ptr<Module>& module, const Edit& edit);
+
+        bool reparse(void);
+        bool parseAgain(void);
+
+        /// Moves the tokens of a kept declaration into the edited source and
+        /// clears what the analyzer derived for it
+        void relocate(AST* node, const bool after_edit);
+        void relocate(Token* token, const bool after_edit);
+
+        /// @return the same text in the edited source, or a copy in the
+        /// arena if the edit changed it
+        std::string_view relocate(const std::string_view text);
+
+        void relocateNames(void);
+    };
+
+}
+
+#endif /* REPARSER_HPP */
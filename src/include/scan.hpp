@@ -0,0 +1,47 @@
+/// *==============================================================*
+///  scan.hpp
+///
+///  Contains the run scanners used by the tokenizer to skip over
+///  whitespace and identifier characters many bytes at a time.
+///  An SSE2 or AVX2 version is picked at startup depending on what
+///  the CPU supports, with a scalar version everywhere else.
+/// *==============================================================*
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+#include "common.hpp"
+
+namespace XC {
+
+    namespace Scan {
+
+        enum class Level : uint8_t {
+            SCALAR,
+            SSE2,
+            AVX2
+        };
+
+        struct Scanners {
+            /// @return the first character in [begin, end) that is not whitespace, or `end`
+            const char* (*skip_whitespace)(const char* begin, const char* end);
+
+            /// @return the first character in [begin, end) that cannot continue an identifier, or `end`
+            const char* (*skip_identifier)(const char* begin, const char* end);
+        };
+
+        /// @return the best level supported by the running CPU
+        Level supported(void);
+
+        /// @return the scanners of the given level (falls back to a lower level if unavailable)
+        const Scanners& at(const Level level);
+
+        /// The scanners of the supported level, chosen once at startup
+        extern const Scanners& scanners;
+
+        const char* levelName(const Level level);
+
+    }
+
+}
+
+#endif /* SCAN_HPP */
@@ -13,11 +13,48 @@ namespace XC {
     struct SourceFile {
     public:
         std::string filename;
-        std::vector<std::string> content;
 
-        void writeOut(void);
+        /// The whole text in one contiguous buffer. Every line, including
+        /// the last one, is terminated by a `\n`.
+        std::string_view content;
+
+        /// Offset of the first character of each line within `content`.
+        std::vector<uint32_t> line_offsets;
+
+        SourceFile(void);
+        ~SourceFile();
+
+        SourceFile(const SourceFile&) = delete;
+        SourceFile& operator=(const SourceFile&) = delete;
+
+        /// @return the number of lines in the file
+        uint32_t lineCount(void) const;
+
+        /// @return the content of the line (with its `\n`)
+        std::string_view lineAt(const uint32_t line) const;
+
+        void appendLine(const std::string& line);
+
+        /// Appends lines that are each terminated by a `\n` already
+        void appendLines(const std::string_view lines);
+
+        /// Writes the content to `filename`, unless the file already holds it,
+        /// so builds that depend on the file do not run again for nothing
+        /// @return `true` if the file was written
+        bool writeOut(void);
 
         static std::unique_ptr<SourceFile> loadContent(const std::string filepath);
+
+        /// @return a file holding the text, as if it was loaded from `filename`
+        static std::unique_ptr<SourceFile> fromText(const std::string filename, std::string text);
+
+    private:
+        std::string buffer;
+
+        void* mapping;
+        size_t mapping_size;
+
+        void indexLines(void);
     };
 
 }
@@ -7,40 +7,75 @@
 
 #include "common.hpp"
 #include "ast.hpp"
+#include "interner.hpp"
 
 namespace XC {
 
     struct SymbolTable {
     public:
-        std::unordered_map<std::string, Declaration*> symbols;
+        std::unordered_map<SymbolId, Declaration*> symbols;
 
         SymbolTable(void);
 
-        Declaration* lookup(const std::string& identifier);
+        Declaration* lookup(const SymbolId identifier);
+
+        /// @return every function loaded, in the order they were loaded in,
+        /// which is the order of the source
+        const std::vector<Function*>& getAllFunctions(void) const;
+        const std::vector<Structure*>& getAllStructures(void) const;
 
-        std::vector<Function*> getAllFunctions(void);
-        std::vector<Structure*> getAllStructures(void);
-        
         bool loadFunction(Function* function);
         bool loadStructure(Structure* structure);
 
-        Function* lookupFunction(const std::string& identifier);
-        Structure* lookupStructure(const std::string& identifier);
+        Function* lookupFunction(const SymbolId identifier);
+        Structure* lookupStructure(const SymbolId identifier);
+
+    private:
+        std::vector<Function*> functions;
+        std::vector<Structure*> structures;
     };
 
+    /// The variables in scope while a function body is validated. Every
+    /// name has a chain of its bindings, innermost first, in one flat array
+    /// indexed by the symbol. Bindings are also logged in the order they
+    /// were made, so leaving a scope unwinds the chains of exactly the names
+    /// it bound. Once the arrays have grown to fit the deepest function,
+    /// scopes are entered and left without allocating.
     struct SymbolStack {
     public:
-        std::vector<std::pair<const AST*, std::unordered_map<std::string, const DataType*>>> stack;
+        struct Scope {
+        public:
+            const AST* parent;
+            uint32_t first_binding; // index in `bindings` of the first one made in the scope
+        };
+
+        std::vector<Scope> scopes;
 
-        SymbolStack(void);
+        /// @param symbol_count the number of names in the module, so the chains fit all of them
+        SymbolStack(const uint32_t symbol_count);
 
         void pushStack(const AST* parent);
 
         void popStack(void);
 
-        void addSymbol(const std::string& identifier, const DataType* type);
+        /// Binds the name in the innermost scope, unless it is bound there already
+        void addSymbol(const SymbolId identifier, const DataType* type);
+
+        /// @return the type of the innermost binding of the name, or nullptr if it is not in scope
+        const DataType* lookupSymbol(const SymbolId identifier) const;
+
+    private:
+        static constexpr uint32_t UNBOUND = UINT32_MAX;
+
+        struct Binding {
+        public:
+            SymbolId identifier;
+            const DataType* type;
+            uint32_t shadowed; // the binding of the same name it hides, or UNBOUND
+        };
 
-        const DataType* lookupSymbol(const std::string& identifier);
+        std::vector<uint32_t> innermost; // by symbol, the index of its innermost binding
+        std::vector<Binding> bindings; // the undo log
     };
 
 }
@@ -2,12 +2,14 @@
 ///  token.hpp
 ///
 ///  Contains the declaration of the TokenType enum, Token struct,
-///  and TokenStream.
+///  and TokenStream class.
 /// *==============================================================*
 #ifndef TOKEN_HPP
 #define TOKEN_HPP
 
 #include "common.hpp"
+#include "sourcefile.hpp"
+#include "interner.hpp"
 
 namespace XC {
 
@@ -100,6 +102,8 @@ namespace XC {
         KEYWORD_ENUM
     };
 
+    static constexpr uint32_t TOKEN_TYPE_COUNT = (uint32_t) TokenType::KEYWORD_ENUM + 1;
+
     struct Token {
     public:
         uint32_t index;
@@ -107,10 +111,71 @@ namespace XC {
         uint32_t column;
 
         TokenType type;
-        std::string lexeme;
+        std::string_view lexeme; // view into the source, or a literal for synthesized tokens
+        SymbolId symbol; // interned lexeme of identifiers and type names, NO_SYMBOL otherwise
     };
 
-    using TokenStream = std::vector<Token>;
+    /// @return `true` if tokens of the type are interned: they name something
+    inline bool isNamed(const TokenType type) {
+        return type == TokenType::IDENTIFIER || (type >= TokenType::TYPE_VOID && type <= TokenType::TYPE_LONG);
+    }
+
+    /// Every significant token of a source file, stored as parallel arrays
+    /// so the parser's type checks walk one byte per token. Lines and
+    /// columns are not stored, they are derived from the offsets on demand.
+    class TokenStream {
+    public:
+        TokenStream(const SourceFile& source);
+
+        void reserve(const size_t capacity);
+        void resize(const size_t size);
+        void append(const TokenType type, const uint32_t offset, const uint32_t length, const SymbolId symbol);
+
+        /// Copies the tokens of `from`, starting at `first`, over the ones
+        /// starting at `at`, translating symbols through `remap` unless it is empty
+        void place(const TokenStream& from, const uint32_t first, const uint32_t at, const std::vector<SymbolId>& remap);
+
+        /// Appends the tokens of `from` in [first, last), their offsets moved by `shift`
+        void appendShifted(const TokenStream& from, const uint32_t first, const uint32_t last, const int64_t shift);
+
+        uint32_t size(void) const {
+            return kinds.size();
+        }
+
+        TokenType type(const uint32_t index) const {
+            return (TokenType) kinds[index];
+        }
+
+        uint32_t offset(const uint32_t index) const {
+            return spans[index].offset;
+        }
+
+        /// @return the index of the first token at or after the offset
+        uint32_t find(const uint32_t offset) const;
+
+        std::string_view lexeme(const uint32_t index) const;
+        uint32_t line(const uint32_t index) const;
+        uint32_t column(const uint32_t index) const;
+
+        SymbolId symbol(const uint32_t index) const {
+            return symbols[index];
+        }
+
+        /// @return the token at the index, with its position located
+        Token at(const uint32_t index) const;
+
+    private:
+        struct Span {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        const SourceFile& source;
+
+        std::vector<uint8_t> kinds;
+        std::vector<Span> spans;
+        std::vector<SymbolId> symbols;
+    };
 
 }
 
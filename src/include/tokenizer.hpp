@@ -1,7 +1,7 @@
 /// *==============================================================*
 ///  tokenizer.hpp
 ///
-///  Contains the declaration for the Tokenizer class. 
+///  Contains the declaration for the Tokenizer class.
 /// *==============================================================*
 #ifndef TOKENIZER_HPP
 #define TOKENIZER_HPP
@@ -17,35 +17,68 @@ namespace XC {
     public:
         Tokenizer(const std::unique_ptr<Module>& module);
 
+        /// Scans up to the next significant token. Once the source is exhausted
+        /// every call returns the END_OF_FILE token.
+        Token nextToken(void);
+
+        /// @return `true` if an error was reported while scanning so far
+        bool hasError(void) const;
+
         static std::unique_ptr<TokenStream> extractTokenStream(const std::unique_ptr<Module>& module);
 
+        // Relexes and reparses the parts of a module an edit touches
+        friend class Reparser;
+
     private:
         const std::unique_ptr<Module>& module;
+        Interner& names;
+
+        const char* begin;
+        const char* limit; // the last `\n` of the source; never scanned, acts as a sentinel
+        const char* stop; // no token starts at or after this, `limit` unless lexing a chunk
+        const char* cursor;
+        const char* lexeme_start;
+
+        uint32_t current_line; // line of the last located offset
+        uint32_t emitted; // number of tokens handed out so far
 
         struct Position {
             uint32_t line;
             uint32_t column;
-        } head, tail;
+        };
 
-        std::string lexeme_buffer;
         std::unique_ptr<TokenStream> tokens;
         bool has_error;
 
+        struct Report {
+            uint32_t offset;
+            std::string text;
+        };
+
+        /// Errors of a chunk are held back until it is known whether the
+        /// chunk was lexed from a real token boundary
+        bool defer_reports;
+        std::vector<Report> reports;
+
+        struct Chunk;
+
+        Tokenizer(const std::unique_ptr<Module>& module, Interner& names, const uint32_t from, const uint32_t to);
+
+        static std::unique_ptr<TokenStream> tokenizeInParallel(const std::unique_ptr<Module>& module, const uint32_t chunk_count);
+
         void tokenize(void);
-        void process(const char c);
-        const std::string& contentOnLine(const uint32_t line);
-        bool atEnd(void);
-        char current(void);
-        char next(void);
-        char peek(void);
-        bool match(char expect);
-        std::string consume(void);
-        void addToken(const TokenType type);
+        TokenType scan(void);
+        TokenType scanSignificant(void);
+        std::string_view contentOnLine(const uint32_t line);
+        std::string_view lexeme(void);
+        SymbolId symbolOf(const TokenType type);
+        Position locate(const uint32_t offset);
         Token createToken(const TokenType type);
 
         TokenType error(const std::string message);
         TokenType error(const std::string message, const char symbol);
 
+        TokenType extractOperator(void);
         TokenType extractSingleLineComment(void);
         TokenType extractMultiLineComment(void);
         TokenType extractIdentifier(void);
@@ -55,9 +88,10 @@ namespace XC {
         TokenType extractOctalLiteral(void);
         TokenType extractHexadecimalLiteral(void);
         TokenType extractNumericLiteral(void);
-        // TokenType extractCharacterLiteral(void);
-        TokenType extractEscapeSequence(void);
         TokenType extractUnrecognizedSymbol(void);
+
+        TokenType extractDigits(const uint8_t digits, const std::string& base);
+        void skipInvalidLiteral(void);
     };
 
 } // namespace XC
@@ -0,0 +1,58 @@
+/// *==============================================================*
+///  tokensource.hpp
+///
+///  Contains the declaration for the TokenSource class, which hands
+///  tokens to the parser either from the materialized token stream
+///  or, when streaming, straight from the tokenizer through a window.
+/// *==============================================================*
+#ifndef TOKENSOURCE_HPP
+#define TOKENSOURCE_HPP
+
+#include "common.hpp"
+#include "xc.hpp"
+#include "token.hpp"
+#include "tokenizer.hpp"
+
+namespace XC {
+
+    class TokenSource {
+    public:
+        TokenSource(const std::unique_ptr<Module>& module, Arena& arena);
+
+        /// @return the token at the index; pulls from the tokenizer as needed when streaming
+        Token at(const uint32_t index);
+
+        /// @return the type of the token at the index, without locating it
+        TokenType type(const uint32_t index);
+
+        /// Allows the tokens before the index to be dropped from the window
+        void release(const uint32_t index);
+
+        /// @return a copy of the token that lives as long as the arena
+        Token* retain(const Token& token);
+
+        /// @return `true` if the tokenizer reported an error
+        bool hasError(void) const;
+
+        /// @return the largest number of tokens held in the window at once
+        uint32_t peakWindowSize(void) const;
+
+    private:
+        const std::unique_ptr<Module>& module;
+        Arena& arena; // where retained tokens go
+
+        std::unique_ptr<Tokenizer> tokenizer; // nullptr -> not streaming
+
+        std::vector<Token> window; // ring buffer, its size is a power of two
+        uint32_t first; // index of the oldest token kept
+        uint32_t end; // index past the newest token pulled
+        uint32_t peak;
+
+        const Token& windowAt(const uint32_t index);
+        void pull(void);
+        void grow(void);
+    };
+
+}
+
+#endif /* TOKENSOURCE_HPP */
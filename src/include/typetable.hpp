@@ -0,0 +1,94 @@
+/// *==============================================================*
+///  typetable.hpp
+///
+///  Contains the declaration of the TypeTable class, which holds
+///  one canonical DataType for every distinct type in a module,
+///  and of the TypeCache class, through which each thread asks it.
+/// *==============================================================*
+#ifndef TYPETABLE_HPP
+#define TYPETABLE_HPP
+
+#include "common.hpp"
+#include "interner.hpp"
+#include "token.hpp"
+#include "ast.hpp"
+
+#include <deque>
+#include <mutex>
+
+namespace XC {
+
+    class TypeTable {
+    public:
+        TypeTable(void);
+
+        /// @return the type with the name, reference and dimensions given,
+        /// made the first time it is asked for. Two types are the same type
+        /// exactly when they are the same pointer.
+        const DataType* get(const SymbolId symbol, const TokenType kind, const std::string_view name, const bool is_reference, const uint32_t dimensions);
+        const DataType* get(const Token* type_name, const bool is_reference, const uint32_t dimensions);
+
+        /// @return the canonical type equal to a type from the tree, or
+        /// nullptr for nullptr
+        const DataType* get(const DataType* type);
+
+        /// @return the number of distinct types made
+        uint32_t size(void);
+
+        /// Forgets every type, for when the symbols they are keyed by change
+        /// meaning. Types handed out before must not be used anymore.
+        void clear(void);
+
+    private:
+        friend class TypeCache;
+
+        struct Key {
+        public:
+            SymbolId symbol;
+            bool is_reference;
+            uint32_t dimensions;
+
+            bool operator==(const Key& other) const;
+        };
+
+        struct KeyHash {
+        public:
+            size_t operator()(const Key& key) const;
+        };
+
+        /// The type, the token naming it and the text of the name, which all
+        /// outlive the source they were first seen in
+        struct Entry {
+        public:
+            DataType type;
+            Token type_name;
+            std::string name;
+        };
+
+        std::unordered_map<Key, const DataType*, KeyHash> types;
+        std::deque<Entry> entries; // never moves what it holds
+
+        std::mutex lock;
+    };
+
+    /// One thread's way into a TypeTable. The types it was handed before are
+    /// found again without taking the table's lock, only the types new to
+    /// it are asked of the table. It must not outlive a clear of the table.
+    class TypeCache {
+    public:
+        TypeCache(TypeTable& table);
+
+        /// @return the same type as the table does
+        const DataType* get(const SymbolId symbol, const TokenType kind, const std::string_view name, const bool is_reference, const uint32_t dimensions);
+        const DataType* get(const Token* type_name, const bool is_reference, const uint32_t dimensions);
+        const DataType* get(const DataType* type);
+
+    private:
+        TypeTable& table;
+
+        std::unordered_map<TypeTable::Key, const DataType*, TypeTable::KeyHash> types; // only touched by the owning thread
+    };
+
+}
+
+#endif /* TYPETABLE_HPP */
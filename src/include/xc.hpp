@@ -8,22 +8,55 @@
 
 #include "common.hpp"
 #include "sourcefile.hpp"
+#include "interner.hpp"
+#include "arena.hpp"
 #include "token.hpp"
 #include "ast.hpp"
 #include "symboltable.hpp"
+#include "typetable.hpp"
+#include "fingerprints.hpp"
+#include "layout.hpp"
+#include "flattree.hpp"
 
 namespace XC {
 
+    struct Options {
+    public:
+        bool stream_tokens = false; // tokenize on demand while parsing instead of up front
+        uint32_t jobs = 1; // threads large files are tokenized, parsed and analyzed on
+        std::string cache_directory; // where parsed modules are kept between compiles, empty -> nowhere
+        bool report_stats = false; // print the tree size, phase times and peak memory once compiled
+        bool incremental = false; // reuse the code of functions unchanged since the last compile
+        bool report_layout = false; // print the size, alignment and padding of every structure
+        bool reorder_members = false; // declare the members of structures in the order that wastes the least padding
+        bool flat_tree = false; // parse into arrays of nodes that refer to each other by index instead of a pointer tree
+    };
+
     struct Module {
     public:
+        Options options;
+
         std::unique_ptr<SourceFile> source;
-        std::unique_ptr<TokenStream> tokens;
-        std::unique_ptr<Program> program;
+        Interner names; // identifiers and type names, viewed from `source`
+        std::unique_ptr<TokenStream> tokens; // nullptr when streaming
+        Arena arena; // the AST, the tokens it references and the types derived by the analyzer, freed at once
+        Program* program = nullptr; // allocated in `arena`
+        std::unique_ptr<FlatTree> flat; // the tree as arrays of nodes, in place of `program` when parsed flat
+        TypeTable types; // the types of expressions, keyed by symbols from `names`
         std::unique_ptr<SymbolTable> symbols;
+        std::unique_ptr<FlatSymbolTable> flat_symbols; // in place of `symbols` when parsed flat
+        std::unique_ptr<Fingerprints> fingerprints; // of the functions, when incremental
+        std::unique_ptr<LayoutTable> layouts; // of the structures, when reported or reordered
         std::unique_ptr<SourceFile> code;
     };
 
-    void compile(const std::string target);
+    /// @return `false` if the target has errors, which were reported
+    bool compile(const std::string target, const Options& options);
+
+    /// Compiles the target, then again every time it is saved, until killed.
+    /// Errors are reported and the target waited on to be fixed.
+    /// @return `false` if the target cannot be watched
+    bool watch(const std::string target, const Options& options);
 
 }
 
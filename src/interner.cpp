@@ -0,0 +1,35 @@
+/// *==============================================================*
+///  interner.cpp
+/// *==============================================================*
+#include "include/interner.hpp"
+
+using namespace XC;
+
+Interner::Interner(void)
+    : ids(),
+      names() {}
+
+SymbolId Interner::intern(const std::string_view name) {
+    const auto [entry, inserted] = ids.try_emplace(name, names.size());
+
+    if (inserted) {
+        names.push_back(name);
+    }
+
+    return entry->second;
+}
+
+std::string_view Interner::name(const SymbolId id) const {
+    return names.at(id);
+}
+
+void Interner::rebind(const SymbolId id, const std::string_view name) {
+    ids.erase(names.at(id));
+    ids.emplace(name, id);
+
+    names[id] = name;
+}
+
+uint32_t Interner::size(void) const {
+    return names.size();
+}
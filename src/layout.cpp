@@ -0,0 +1,172 @@
+/// *==============================================================*
+///  layout.cpp
+/// *==============================================================*
+#include "include/layout.hpp"
+
+#include <algorithm>
+
+using namespace XC;
+
+static constexpr uint8_t LAYOUT_NOT_STARTED = 0;
+static constexpr uint8_t LAYOUT_STARTED = 1;
+static constexpr uint8_t LAYOUT_DONE = 2;
+
+static uint32_t alignUp(const uint32_t offset, const uint32_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+LayoutTable::LayoutTable(SymbolTable& symbols)
+    : symbols(symbols),
+      layouts(symbols.getAllStructures().size()),
+      states(symbols.getAllStructures().size(), LAYOUT_NOT_STARTED),
+      indices() {
+    const std::vector<Structure*>& structures = symbols.getAllStructures();
+
+    for (uint32_t index = 0; index < structures.size(); ++index) {
+        indices.emplace(structures[index], index);
+    }
+
+    for (uint32_t index = 0; index < structures.size(); ++index) {
+        layOut(index);
+    }
+}
+
+const StructureLayout& LayoutTable::layoutOf(const uint32_t index) const {
+    return layouts[index];
+}
+
+std::unique_ptr<LayoutTable> LayoutTable::computeLayouts(SymbolTable& symbols) {
+    return std::make_unique<LayoutTable>(symbols);
+}
+
+const StructureLayout& LayoutTable::layOut(const uint32_t index) {
+    StructureLayout& layout = layouts[index];
+
+    // A structure reached again while it is being laid out holds itself
+    if (states[index] != LAYOUT_NOT_STARTED) {
+        return layout;
+    }
+
+    states[index] = LAYOUT_STARTED;
+
+    const Structure* structure = symbols.getAllStructures()[index];
+    const uint32_t member_count = structure->members != nullptr ? structure->members->members.size() : 0;
+
+    std::vector<uint32_t> sizes(member_count);
+    std::vector<uint32_t> packed_sizes(member_count);
+    std::vector<uint32_t> alignments(member_count);
+
+    layout.is_known = true;
+    layout.alignment = 1;
+
+    for (uint32_t member = 0; member < member_count; ++member) {
+        const DataType* type = structure->members->members[member]->data_type;
+
+        if (!measure(type, sizes[member], packed_sizes[member], alignments[member])) {
+            layout.is_known = false;
+        }
+
+        layout.alignment = max_of(layout.alignment, alignments[member]);
+    }
+
+    layout.packed_order.resize(member_count);
+    for (uint32_t member = 0; member < member_count; ++member) {
+        layout.packed_order[member] = member;
+    }
+
+    if (!layout.is_known) {
+        layout.size = layout.padding = layout.packed_size = layout.packed_padding = 0;
+        states[index] = LAYOUT_DONE;
+        return layout;
+    }
+
+    // Every member is placed at the next offset its alignment allows, and the
+    // whole is rounded up so the members of an array of it stay aligned
+    const auto place = [&](const std::vector<uint32_t>& order, const std::vector<uint32_t>& member_sizes, uint32_t& size, uint32_t& padding) {
+        uint32_t offset = 0;
+        uint32_t used = 0;
+
+        for (const uint32_t member : order) {
+            offset = alignUp(offset, alignments[member]) + member_sizes[member];
+            used += member_sizes[member];
+        }
+
+        size = alignUp(offset, layout.alignment);
+        padding = size - used;
+    };
+
+    place(layout.packed_order, sizes, layout.size, layout.padding);
+
+    // The size of a C type is a multiple of its alignment, and alignments are
+    // powers of two, so the most aligned members first leave no gap between
+    // members, only at the end
+    std::vector<uint32_t> order = layout.packed_order;
+    std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return alignments[a] > alignments[b];
+    });
+
+    uint32_t size_in_order;
+    uint32_t padding_in_order;
+    place(layout.packed_order, packed_sizes, size_in_order, padding_in_order);
+    place(order, packed_sizes, layout.packed_size, layout.packed_padding);
+
+    if (layout.packed_size < size_in_order) {
+        layout.packed_order.swap(order);
+    } else {
+        layout.packed_size = size_in_order;
+        layout.packed_padding = padding_in_order;
+    }
+
+    states[index] = LAYOUT_DONE;
+    return layout;
+}
+
+bool LayoutTable::measure(const DataType* type, uint32_t& size, uint32_t& packed_size, uint32_t& alignment) {
+    size = packed_size = alignment = 1;
+
+    // Sized as the generated C declares the member, where a reference is a
+    // pointer and dimensions are not spelled out
+    if (type->is_reference) {
+        size = packed_size = sizeof(void*);
+        alignment = alignof(void*);
+        return true;
+    }
+
+    switch (type->type_name->type) {
+        case TokenType::TYPE_BOOL: size = sizeof(bool); alignment = alignof(bool); break;
+        case TokenType::TYPE_FLOAT: size = sizeof(float); alignment = alignof(float); break;
+        case TokenType::TYPE_DOUBLE: size = sizeof(double); alignment = alignof(double); break;
+        case TokenType::TYPE_BYTE: size = sizeof(int8_t); alignment = alignof(int8_t); break;
+        case TokenType::TYPE_SHORT: size = sizeof(int16_t); alignment = alignof(int16_t); break;
+        case TokenType::TYPE_INT: size = sizeof(int32_t); alignment = alignof(int32_t); break;
+        case TokenType::TYPE_LONG: size = sizeof(int64_t); alignment = alignof(int64_t); break;
+        case TokenType::IDENTIFIER: {
+            const Structure* structure = symbols.lookupStructure(type->type_name->symbol);
+
+            if (structure == nullptr) {
+                return false;
+            }
+
+            const uint32_t index = indices.at(structure);
+            if (states[index] == LAYOUT_STARTED) {
+                return false;
+            }
+
+            const StructureLayout& held = layOut(index);
+            if (!held.is_known) {
+                return false;
+            }
+
+            size = held.size;
+            packed_size = held.packed_size;
+            alignment = held.alignment;
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+
+    packed_size = size;
+    return true;
+}
@@ -5,13 +5,68 @@
 
 using namespace XC;
 
+static void usage(void) {
+    std::cerr << "usage:\n\txc [OPTIONS] [TARGET]\n\n"
+              << "options:\n"
+              << "\t--stream\ttokenize while parsing instead of up front\n"
+              << "\t--jobs N\ttokenize, parse and analyze large files on N threads\n"
+              << "\t--cache DIR\treuse the tokens and tree of unchanged sources from DIR\n"
+              << "\t--incremental\tskip analyzing and generating functions unchanged since the last compile\n"
+              << "\t--layout-report\treport the size, alignment and padding of every struct\n"
+              << "\t--pack-structs\treorder the members of structs to waste the least padding\n"
+              << "\t--flat-ast\tparse into arrays of nodes linked by index instead of pointers\n"
+              << "\t--stats\t\treport tree size, phase times and peak memory\n"
+              << "\t--watch\t\tcompile again whenever the target is saved, until killed" << std::endl;
+    exit(EXIT_FAILURE);
+}
+
 int main(int argc, char** argv) {
-    if (argc <= 1) {
-        std::cerr << "usage:\n\txc [TARGET]" << std::endl;
-        exit(EXIT_FAILURE);
+    Options options;
+    std::string target;
+    bool watching = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument(argv[i]);
+
+        if (argument == "--stream") {
+            options.stream_tokens = true;
+        } else if (argument == "--stats") {
+            options.report_stats = true;
+        } else if (argument == "--incremental") {
+            options.incremental = true;
+        } else if (argument == "--layout-report") {
+            options.report_layout = true;
+        } else if (argument == "--pack-structs") {
+            options.reorder_members = true;
+        } else if (argument == "--flat-ast") {
+            options.flat_tree = true;
+        } else if (argument == "--watch") {
+            watching = true;
+        } else if (argument == "--jobs" && i + 1 < argc) {
+            options.jobs = std::strtoul(argv[++i], nullptr, 10);
+
+            if (options.jobs == 0) {
+                usage();
+            }
+        } else if (argument == "--cache" && i + 1 < argc) {
+            options.cache_directory = argv[++i];
+        } else if (argument.size() > 1 && argument[0] == '-') {
+            std::cerr << "xc: \033[31merror\033[0m: unknown option: `" << argument << '`' << std::endl;
+            usage();
+        } else if (target.empty()) {
+            target = argument;
+        } else {
+            usage();
+        }
     }
 
-    compile(std::string(argv[1]));
+    if (target.empty()) {
+        usage();
+    }
+
+    if (watching) {
+        return watch(target, options) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
 
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    return compile(target, options) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
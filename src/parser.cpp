@@ -3,64 +3,186 @@
 /// *==============================================================*
 #include "include/parser.hpp"
 
+#include <array>
+#include <thread>
+
 using namespace XC;
 
+// Below this many tokens a chunk takes less to parse than a thread takes to start
+static constexpr uint32_t MIN_CHUNK_SIZE = 1 << 18;
+
+struct Parser::Chunk {
+    uint32_t from;
+    uint32_t to;
+
+    Arena arena; // absorbed into the module's once the chunk is stitched
+    std::unique_ptr<Parser> parser;
+};
+
 Parser::Parser(const std::unique_ptr<Module>& module)
+    : Parser(module, module->arena) {
+    const uint32_t chunks_fitting = module->tokens == nullptr ? 1 : max_of(module->tokens->size() / MIN_CHUNK_SIZE, 1);
+    const uint32_t chunk_count = min_of(module->options.jobs, chunks_fitting);
+
+    if (chunk_count > 1) {
+        parseInParallel(chunk_count);
+    } else {
+        parse(UINT32_MAX);
+    }
+
+    // A lexical error means the parse errors are only noise, the tokenizer
+    // has already reported its own while being pulled
+    if (tokens.hasError()) {
+        has_error = true;
+    } else {
+        std::cerr << reports;
+    }
+
+    // if (!has_error) {
+    //     printTree(program.get(), "", true);
+    // }
+}
+
+Parser::Parser(const std::unique_ptr<Module>& module, Arena& arena)
     : module(module),
+      arena(arena),
       position(0),
-      program(std::make_unique<Program>()),
-      has_error(false) {
-    parse();
+      tokens(module, arena),
+      program(arena.make<Program>()),
+      flat(nullptr),
+      has_error(false) {}
+
+void Parser::parseInParallel(const uint32_t chunk_count) {
+    const uint32_t size = module->tokens->size() - 1; // END_OF_FILE stays out of every chunk
+
+    // Chunks end on a `}` closing the outermost brace, which is where every
+    // well-formed declaration ends
+    std::deque<Chunk> chunks;
+    {
+        uint32_t depth = 0;
+        uint32_t from = 0;
+
+        for (uint32_t index = 0; index < size && chunks.size() + 1 < chunk_count; ++index) {
+            const TokenType type = module->tokens->type(index);
+
+            if (type == TokenType::PUNCTUATION_LEFT_BRACE) {
+                ++depth;
+            } else if (type == TokenType::PUNCTUATION_RIGHT_BRACE) {
+                depth = depth == 0 ? 0 : depth - 1;
+
+                const uint32_t even_split = (uint64_t) size * (chunks.size() + 1) / chunk_count;
+
+                if (depth == 0 && index + 1 >= even_split) {
+                    Chunk& chunk = chunks.emplace_back();
+                    chunk.from = from;
+                    chunk.to = index + 1;
+
+                    from = chunk.to;
+                }
+            }
+        }
+
+        Chunk& chunk = chunks.emplace_back();
+        chunk.from = from;
+        chunk.to = size;
+    }
+
+    // Every chunk is parsed as if a declaration started where it does
+    {
+        std::vector<std::thread> workers;
+
+        for (Chunk& chunk : chunks) {
+            workers.emplace_back([this, &chunk] {
+                chunk.parser.reset(new Parser(module, chunk.arena));
+                chunk.parser->position = chunk.from;
+                chunk.parser->parse(chunk.to);
+            });
+        }
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Only a chunk starting where the previous one stopped was parsed from a
+    // real declaration boundary. Error recovery in a malformed declaration can
+    // run past the end of its chunk, the next chunk is then parsed again from
+    // where it stopped. Reports are appended in order so they come out the
+    // same as with a single parser.
+    for (Chunk& chunk : chunks) {
+        if (position >= chunk.to) {
+            continue; // swallowed by recovery in an earlier chunk
+        }
+
+        if (position != chunk.from) {
+            parse(chunk.to);
+            continue;
+        }
+
+        const Parser& parser = *chunk.parser;
+
+        for (Declaration* declaration : parser.program->declarations) {
+            program->declarations.push_back(declaration);
+        }
+
+        reports.append(parser.reports);
+        has_error = has_error || parser.has_error;
+        position = parser.position;
+
+        arena.absorb(chunk.arena);
+    }
 }
 
-void Parser::parse(void) {
-    if (atEnd()) return;
+void Parser::parse(const uint32_t limit) {
+    while (!atEnd() && position < limit) {
+        // Errors point at the token before them, everything else at or after
+        tokens.release(max_of(position, 1) - 1);
 
-    while (!atEnd()) {
         Declaration* declaration = (Declaration*) parseDeclaration();
 
         if (ErrorNode* error = get_node_if(declaration, ErrorNode)) {
             reportError(error);
-            delete declaration;
 
             // try to recover
-            while (!atEnd() && !(consumeIf(TokenType::PUNCTUATION_SEMI_COLON) || consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE))) next();
+            while (!atEnd() && !(consumeIf(TokenType::PUNCTUATION_SEMI_COLON) || consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE))) skip();
+        } else if (flat != nullptr) {
+            // Only the copy is kept, the arena is the parser's own
+            flat->append(declaration);
+            arena.clear();
         } else {
             program->declarations.push_back(declaration);
         }
     }
-
-    // if (!has_error) {
-    //     printTree(program.get(), "", true);
-    // }
 }
 
 bool Parser::atEnd(void) {
-    return current().type == TokenType::END_OF_FILE;
+    return tokens.type(position) == TokenType::END_OF_FILE;
 }
 
-const Token& Parser::current(void) {
-    return module->tokens->at(position);
+Token Parser::current(void) {
+    return tokens.at(position);
 }
 
-const Token& Parser::next(void) {
-    const Token& now = current();
+Token Parser::next(void) {
+    const Token now = current();
 
-    if (atEnd()) {
-        return now;
-    }
-
-    ++position;
+    skip();
 
     return now;
 }
 
-const Token& Parser::peek(void) {
+void Parser::skip(void) {
+    if (!atEnd()) {
+        ++position;
+    }
+}
+
+Token Parser::peek(void) {
     if (atEnd()) {
         return current();
     }
 
-    return module->tokens->at(position + 1);
+    return tokens.at(position + 1);
 }
 
 bool Parser::match(const TokenType expect) {
@@ -68,15 +190,15 @@ bool Parser::match(const TokenType expect) {
         return false;
     }
 
-    return current().type == expect;
+    return tokens.type(position) == expect;
 }
 
 bool Parser::matchNext(const TokenType expect) {
-    if (atEnd() && expect != TokenType::END_OF_FILE) {
-        return false;
+    if (atEnd()) {
+        return expect == TokenType::END_OF_FILE;
     }
 
-    return peek().type == expect;
+    return tokens.type(position + 1) == expect;
 }
 
 
@@ -91,9 +213,9 @@ bool Parser::consumeIf(const TokenType expect) {
 }
 
 ErrorNode* Parser::error(const std::string message) {
-    ErrorNode* err = new ErrorNode;
+    ErrorNode* err = arena.make<ErrorNode>();
 
-    err->reason = message;
+    err->reason = arena.copy(message);
     err->occurrence = position;
 
     return err;
@@ -106,9 +228,9 @@ void Parser::reportError(ErrorNode*& error) {
     // ln | content         |< line content
     //    : underline       |< footer
 
-    const std::string& message = error->reason;
-    Token& left_token = module->tokens->at(max_of(error->occurrence, 1) - 1);
-    Token& right_token = module->tokens->at(error->occurrence);
+    const std::string message(error->reason);
+    const Token left_token = tokens.at(max_of(error->occurrence, 1) - 1);
+    const Token right_token = tokens.at(error->occurrence);
 
     const uint32_t occurrence_line = left_token.line;
     const uint32_t occurrence_column = left_token.column + left_token.lexeme.size();
@@ -121,9 +243,9 @@ void Parser::reportError(ErrorNode*& error) {
     {
         const std::string line_number = std::to_string(occurrence_line + 1);
         const std::string divider = std::string(line_number.size() + 2, ' ') + ':';
-        const std::string line = module->source->content.at(occurrence_line); 
+        const std::string_view line = module->source->lineAt(occurrence_line);
 
-        const std::string line_content = " " + line_number + " | " + line;
+        const std::string line_content = " " + line_number + " | " + std::string(line);
 
         std::string underline;
         {
@@ -147,7 +269,7 @@ void Parser::reportError(ErrorNode*& error) {
         preview = divider + '\n' + line_content + footer;
     }
 
-    std::cerr << header << info << preview << std::endl;
+    reports.append(header + info + preview + '\n');
 
     has_error = true;
 
@@ -157,67 +279,61 @@ void Parser::reportError(ErrorNode*& error) {
 }
 
 AST* Parser::parseDeclaration(void) {
-    return tryParse({
-        &Parser::parseStructure,
-        &Parser::parseFunction
-    }, "expected declaration");
+    if (match(TokenType::KEYWORD_STRUCT)) {
+        return parsePredicted(&Parser::parseStructure, "expected declaration");
+    }
+
+    return parsePredicted(&Parser::parseFunction, "expected declaration");
 }
 
 AST* Parser::parseFunction(void) {
-    Function* function = new Function;
-    ErrorNode* errors = new ErrorNode;
+    Function* function = arena.make<Function>();
+    ErrorNode errors;
 
     if (match(TokenType::IDENTIFIER) && matchNext(TokenType::PUNCTUATION_DOUBLE_COLON)) {
-        function->owner = &next();
+        function->owner = tokens.retain(next());
 
-        next(); // ::
+        skip(); // ::
     }
 
     if (!consumeIf(TokenType::TYPE_VOID)) {
         function->return_type = (DataType*) parseDataType();
         if (ErrorNode* error_in_return_type = get_node_if(function->return_type, ErrorNode)) {
             function->return_type = nullptr;
-            errors->appendError(error_in_return_type);
+            errors.appendError(error_in_return_type);
         }
     }
     
     if (!match(TokenType::IDENTIFIER)) {
-        errors->appendError(error("expected identifier"));
+        errors.appendError(error("expected identifier"));
     } else {
-        function->name = &next();
+        function->name = tokens.retain(next());
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_LEFT_PARENTHESIS)) {
-        errors->appendError(error("expected `(`"));
+        errors.appendError(error("expected `(`"));
     }
 
     if (!consumeIf(TokenType::TYPE_VOID)) {
-        function->parameters = (ParameterList*) tryParse({&Parser::parseParameters}, "expected parameters");
+        function->parameters = (ParameterList*) parsePredicted(&Parser::parseParameters, "expected parameters");
         if (ErrorNode* error_in_parameters = get_node_if(function->parameters, ErrorNode)) {
             function->parameters = nullptr;
-            errors->appendError(error_in_parameters);
+            errors.appendError(error_in_parameters);
         }
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_RIGHT_PARENTHESIS)) {
-        errors->appendError(error("expected `)`"));
+        errors.appendError(error("expected `)`"));
     }
 
     function->body = (BlockStatement*) parseBlockStatement();
     if (ErrorNode* error_in_body = get_node_if(function->body, ErrorNode)) {
         function->body = nullptr;
-        errors->appendError(error_in_body);
+        errors.appendError(error_in_body);
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete function;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return function;
@@ -228,59 +344,51 @@ AST* Parser::parseStructure(void) {
         return error("expected keyword `struct`");
     }
 
-    Structure* structure = new Structure;
-    ErrorNode* errors = new ErrorNode;
+    Structure* structure = arena.make<Structure>();
+    ErrorNode errors;
 
     if (!match(TokenType::IDENTIFIER)) {
-        errors->appendError(error("expected identifier"));
+        errors.appendError(error("expected identifier"));
     } else {
-        structure->name = &next();
+        structure->name = tokens.retain(next());
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_LEFT_BRACE)) {
-        errors->appendError(error("expected `{`"));
+        errors.appendError(error("expected `{`"));
     }
 
-    structure->members = (StructureMembers*) tryParse({&Parser::parseStructureMembers}, "expected structure members");
+    structure->members = (StructureMembers*) parsePredicted(&Parser::parseStructureMembers, "expected structure members");
     if (ErrorNode* error_in_members = get_node_if(structure->members, ErrorNode)) {
         structure->members = nullptr;
-        errors->appendError(error_in_members);
+        errors.appendError(error_in_members);
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE)) {
-        errors->appendError(error("expected `}`"));
+        errors.appendError(error("expected `}`"));
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete structure;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return structure;
 }
 
 AST* Parser::parseStructureMembers(void) {
-    StructureMembers* structure_members = new StructureMembers;
+    StructureMembers* structure_members = arena.make<StructureMembers>();
 
-    ErrorNode* errors = new ErrorNode;
+    ErrorNode errors;
 
     do {
         VariableDeclarator* member = (VariableDeclarator*) parseVariableDeclarator();
         if (ErrorNode* error_in_member = get_node_if(member, ErrorNode)) {
-            errors->appendError(error_in_member);
+            errors.appendError(error_in_member);
 
             // try to recover
-            while (!atEnd() && !(consumeIf(TokenType::PUNCTUATION_SEMI_COLON) || match(TokenType::PUNCTUATION_RIGHT_BRACE))) next();
+            while (!atEnd() && !(consumeIf(TokenType::PUNCTUATION_SEMI_COLON) || match(TokenType::PUNCTUATION_RIGHT_BRACE))) skip();
         } else {
             if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
-                delete member;
-                errors->appendError(error("expected `;`"));
+                errors.appendError(error("expected `;`"));
 
             } else {
                 structure_members->members.push_back(member);
@@ -288,110 +396,137 @@ AST* Parser::parseStructureMembers(void) {
         }
     } while(!atEnd() && !match(TokenType::PUNCTUATION_RIGHT_BRACE));
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete structure_members;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return structure_members;
 }
 
 AST* Parser::parseParameters(void) {
-    ParameterList* parameter_list = new ParameterList;
+    ParameterList* parameter_list = arena.make<ParameterList>();
 
-    ErrorNode* errors = new ErrorNode;
+    ErrorNode errors;
 
     do {
         VariableDeclarator* parameter = (VariableDeclarator*) parseVariableDeclarator();
 
         if (ErrorNode* error_in_parameter = get_node_if(parameter, ErrorNode)) {
-            errors->appendError(error_in_parameter);
+            errors.appendError(error_in_parameter);
         } else {
             parameter_list->parameters.push_back(parameter);
         }
 
     } while (!atEnd() && consumeIf(TokenType::PUNCTUATION_COMMA));
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete parameter_list;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return parameter_list;
 }
 
 AST* Parser::parseBlockStatement(void) {
-    ErrorNode* errors = new ErrorNode;
+    ErrorNode errors;
 
     if (!consumeIf(TokenType::PUNCTUATION_LEFT_BRACE)) {
-        errors->appendError(error("expected `{"));
+        errors.appendError(error("expected `{"));
     }
 
-    BlockStatement* block = new BlockStatement;
+    BlockStatement* block = arena.make<BlockStatement>();
 
     while (!atEnd() && !match(TokenType::PUNCTUATION_RIGHT_BRACE)) {
         Statement* statement = (Statement*) parseStatement();
 
         if (ErrorNode* error_in_statement = get_node_if(statement, ErrorNode)) {
-            errors->appendError(error_in_statement);
+            errors.appendError(error_in_statement);
 
             // will try to recover
-            while (!atEnd() && !consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE)) next();
+            while (!atEnd() && !consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE)) skip();
         } else {
             block->statements.push_back(statement);
         }
     }
 
     if (atEnd() || !consumeIf(TokenType::PUNCTUATION_RIGHT_BRACE)) {
-        errors->appendError(error("expected `}`"));
+        errors.appendError(error("expected `}`"));
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete block;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return block;
 }
 
 AST* Parser::parseStatement(void) {
-    return tryParse({
-        &Parser::parseExpressionStatement,
-        &Parser::parseVariableDeclarationStatement,
-        &Parser::parseConditionalStatement,
-        &Parser::parseWhileIteration,
-        &Parser::parseForIteration,
-        &Parser::parseReturnStatement,
-        &Parser::parseContinueStatement,
-        &Parser::parseBreakStatement
-    }, "expected statement");
+    ProductionRule rule = &Parser::parseExpressionStatement;
+
+    switch (tokens.type(position)) {
+        case TokenType::KEYWORD_IF:
+            rule = &Parser::parseConditionalStatement;
+            break;
+        case TokenType::KEYWORD_WHILE:
+            rule = &Parser::parseWhileIteration;
+            break;
+        case TokenType::KEYWORD_FOR:
+            rule = &Parser::parseForIteration;
+            break;
+        case TokenType::KEYWORD_RETURN:
+            rule = &Parser::parseReturnStatement;
+            break;
+        case TokenType::KEYWORD_CONTINUE:
+            rule = &Parser::parseContinueStatement;
+            break;
+        case TokenType::KEYWORD_BREAK:
+            rule = &Parser::parseBreakStatement;
+            break;
+        default:
+            if (startsVariableDeclaration()) {
+                rule = &Parser::parseVariableDeclarationStatement;
+            }
+            break;
+    }
+
+    return parsePredicted(rule, "expected statement");
+}
+
+bool Parser::startsVariableDeclaration(void) {
+    // `&` is also the reference-of operator: `&x;` is an expression
+    const uint32_t type_name = match(TokenType::BITWISE_OP_AND) ? position + 1 : position;
+
+    switch (tokens.type(type_name)) {
+        case TokenType::TYPE_BOOL:
+        case TokenType::TYPE_BYTE:
+        case TokenType::TYPE_SHORT:
+        case TokenType::TYPE_INT:
+        case TokenType::TYPE_LONG:
+        case TokenType::TYPE_FLOAT:
+        case TokenType::TYPE_DOUBLE:
+            return true;
+        case TokenType::IDENTIFIER:
+            break;
+        default:
+            return false;
+    }
+
+    // `T x` or `T[] x`, no expression has two identifiers in a row or an empty `[]`
+    switch (tokens.type(type_name + 1)) {
+        case TokenType::IDENTIFIER:
+            return true;
+        case TokenType::PUNCTUATION_LEFT_BRACKET:
+            return tokens.type(type_name + 2) == TokenType::PUNCTUATION_RIGHT_BRACKET;
+        default:
+            return false;
+    }
 }
 
 AST* Parser::parseExpressionStatement(void) {
-    ExpressionStatement* expression_statement = new ExpressionStatement;
+    ExpressionStatement* expression_statement = arena.make<ExpressionStatement>();
 
     expression_statement->expression = (Expression*) parseExpression();
     if (ErrorNode* error_found = get_node_if(expression_statement->expression, ErrorNode)) {
         expression_statement->expression = nullptr;
-        delete expression_statement;
 
         if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
             error_found->appendError(error("expected `;`"));
@@ -401,7 +536,6 @@ AST* Parser::parseExpressionStatement(void) {
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
-        delete expression_statement;
         return error("expected `;`");
     }
 
@@ -409,13 +543,13 @@ AST* Parser::parseExpressionStatement(void) {
 }
 
 AST* Parser::parseVariableDeclarationStatement(void) {
-    VariableDeclarationStatement* variable_declaration = new VariableDeclarationStatement;
-    ErrorNode* errors = new ErrorNode;
+    VariableDeclarationStatement* variable_declaration = arena.make<VariableDeclarationStatement>();
+    ErrorNode errors;
 
     variable_declaration->declarator = (VariableDeclarator*) parseVariableDeclarator();
     if (ErrorNode* error_in_declarator = get_node_if(variable_declaration->declarator, ErrorNode)) {
         variable_declaration->declarator = nullptr;
-        errors->appendError(error_in_declarator);
+        errors.appendError(error_in_declarator);
     }
 
     if (consumeIf(TokenType::ASSIGNMENT_ASSIGN)) {
@@ -423,23 +557,16 @@ AST* Parser::parseVariableDeclarationStatement(void) {
 
         if (ErrorNode* error_in_inital_value = get_node_if(variable_declaration->initial, ErrorNode)) {
             variable_declaration->initial = nullptr;
-            errors->appendError(error_in_inital_value);
+            errors.appendError(error_in_inital_value);
         }
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
-        errors->appendError(error("expected `;`"));
+        errors.appendError(error("expected `;`"));
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete variable_declaration;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return variable_declaration;
@@ -450,30 +577,23 @@ AST* Parser::parseWhileIteration(void) {
         return error("expected keyword `while`");
     }
 
-    WhileIteration* iteration = new WhileIteration;
-    ErrorNode* errors = new ErrorNode;
+    WhileIteration* iteration = arena.make<WhileIteration>();
+    ErrorNode errors;
 
     iteration->condition = (Expression*) parseGrouping();
     if (ErrorNode* error_in_condition = get_node_if(iteration->condition, ErrorNode)) {
         iteration->condition = nullptr;
-        errors->appendError(error_in_condition);
+        errors.appendError(error_in_condition);
     }
 
     iteration->body = (BlockStatement*) parseBlockStatement();
     if (ErrorNode* error_in_body = get_node_if(iteration->body, ErrorNode)) {
         iteration->body = nullptr;
-        errors->appendError(error_in_body);
+        errors.appendError(error_in_body);
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete iteration;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return iteration;
@@ -484,18 +604,18 @@ AST* Parser::parseForIteration(void) {
         return error("expected keyword `for`");
     }
 
-    ForIteration* iteration = new ForIteration;
-    ErrorNode* errors = new ErrorNode;
+    ForIteration* iteration = arena.make<ForIteration>();
+    ErrorNode errors;
 
     if (!consumeIf(TokenType::PUNCTUATION_LEFT_PARENTHESIS)) {
-        errors->appendError(error("expected `(`"));
+        errors.appendError(error("expected `(`"));
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
         iteration->initial = (VariableDeclarationStatement*) parseVariableDeclarationStatement();
         if (ErrorNode* error_in_init = get_node_if(iteration->initial, ErrorNode)) {
             iteration->initial = nullptr;
-            errors->appendError(error_in_init);
+            errors.appendError(error_in_init);
         }
     }
 
@@ -503,11 +623,11 @@ AST* Parser::parseForIteration(void) {
         iteration->condition = (Expression*) parseExpression();
         if (ErrorNode* error_in_condition = get_node_if(iteration->condition, ErrorNode)) {
             iteration->condition = nullptr;
-            errors->appendError(error_in_condition);
+            errors.appendError(error_in_condition);
         }
 
         if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
-            errors->appendError(error("expected `;`"));
+            errors.appendError(error("expected `;`"));
         }
     }
 
@@ -515,29 +635,22 @@ AST* Parser::parseForIteration(void) {
         iteration->update = (Expression*) parseExpression();
         if (ErrorNode* error_in_update = get_node_if(iteration->update, ErrorNode)) {
             iteration->update = nullptr;
-            errors->appendError(error_in_update);
+            errors.appendError(error_in_update);
         }
 
         if (!consumeIf(TokenType::PUNCTUATION_RIGHT_PARENTHESIS)) {
-            errors->appendError(error("expected `)`"));
+            errors.appendError(error("expected `)`"));
         }
     }
 
     iteration->body = (BlockStatement*) parseBlockStatement();
     if (ErrorNode* error_in_body = get_node_if(iteration->body, ErrorNode)) {
         iteration->body = nullptr;
-        errors->appendError(error_in_body);
+        errors.appendError(error_in_body);
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete iteration;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return iteration;
@@ -548,13 +661,12 @@ AST* Parser::parseReturnStatement(void) {
         return error("expected keyword `return`");
     }
 
-    ReturnStatement* _return = new ReturnStatement;
+    ReturnStatement* _return = arena.make<ReturnStatement>();
 
     if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
         _return->expression = (Expression*) parseExpression();
         if (ErrorNode* error_found = get_node_if(_return->expression, ErrorNode)) {
             _return->expression = nullptr;
-            delete _return;
 
             if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
                 error_found->appendError(error("expected `;`"));
@@ -564,7 +676,6 @@ AST* Parser::parseReturnStatement(void) {
         }
 
         if (!consumeIf(TokenType::PUNCTUATION_SEMI_COLON)) {
-            delete _return;
             return error("expected `;`");
         }
     }
@@ -581,7 +692,7 @@ AST* Parser::parseContinueStatement(void) {
         return error("expected `;`");
     }
 
-    return new ContinueStatement;
+    return arena.make<ContinueStatement>();
 }
 
 AST* Parser::parseBreakStatement(void) {
@@ -593,7 +704,7 @@ AST* Parser::parseBreakStatement(void) {
         return error("expected `;`");
     }
 
-    return new BreakStatement;
+    return arena.make<BreakStatement>();
 }
 
 AST* Parser::parseConditionalStatement(void) {
@@ -601,49 +712,42 @@ AST* Parser::parseConditionalStatement(void) {
         return error("expected keyword `if`");
     }
 
-    ConditionalStatement* conditional = new ConditionalStatement;
-    ErrorNode* errors = new ErrorNode;
+    ConditionalStatement* conditional = arena.make<ConditionalStatement>();
+    ErrorNode errors;
 
     conditional->condition = (Expression*) parseGrouping();
     if (ErrorNode* error = get_node_if(conditional->condition, ErrorNode)) {
-        errors->appendError(error);
+        errors.appendError(error);
         conditional->condition = nullptr;
     }
 
     conditional->body = (BlockStatement*) parseBlockStatement();
     if (ErrorNode* error = get_node_if(conditional->body, ErrorNode)) {
-        errors->appendError(error);
+        errors.appendError(error);
         conditional->body = nullptr;
     }
 
     if (consumeIf(TokenType::KEYWORD_ELSE)) {
-        conditional->else_case = (ConditionalStatement*) tryParse({
-            &Parser::parseConditionalStatement,
-            &Parser::parseBlockStatement
-        }, "expected keyword `if` or `{`");
+        conditional->else_case = (ConditionalStatement*) parsePredicted(
+            match(TokenType::KEYWORD_IF) ? &Parser::parseConditionalStatement : &Parser::parseBlockStatement,
+            "expected keyword `if` or `{`"
+        );
     }
 
     if (ErrorNode* error = get_node_if(conditional->else_case, ErrorNode)) {
-        errors->appendError(error);
+        errors.appendError(error);
         conditional->else_case = nullptr;
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete conditional;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return conditional;
 }
 
 AST* Parser::parseDataType(void) {
-    DataType* data_type = new DataType;
+    DataType* data_type = arena.make<DataType>();
 
     data_type->is_reference = consumeIf(TokenType::BITWISE_OP_AND);
 
@@ -658,17 +762,16 @@ AST* Parser::parseDataType(void) {
         || match(TokenType::TYPE_FLOAT)
         || match(TokenType::TYPE_DOUBLE))
     ) {
-        delete data_type;
         return error("expected identifier, or type");
     }
 
-    data_type->type_name = &next();
+    data_type->type_name = tokens.retain(next());
 
     data_type->dimensions = 0;
 
     while (!atEnd() && (match(TokenType::PUNCTUATION_LEFT_BRACKET) && matchNext(TokenType::PUNCTUATION_RIGHT_BRACKET))) {
-        next(); // [
-        next(); // ]
+        skip(); // [
+        skip(); // ]
         ++data_type->dimensions;
     }
 
@@ -676,244 +779,101 @@ AST* Parser::parseDataType(void) {
 }
 
 AST* Parser::parseVariableDeclarator(void) {
-    VariableDeclarator* declarator = new VariableDeclarator;
-    ErrorNode* errors = new ErrorNode;
+    VariableDeclarator* declarator = arena.make<VariableDeclarator>();
+    ErrorNode errors;
 
     declarator->data_type = (DataType*) parseDataType();
     if (ErrorNode* error_in_data_type = get_node_if(declarator->data_type, ErrorNode)) {
         declarator->data_type = nullptr;
-        errors->appendError(error_in_data_type);
+        errors.appendError(error_in_data_type);
     }
 
     if (!match(TokenType::IDENTIFIER)) {
-        errors->appendError(error("expected identifier"));
+        errors.appendError(error("expected identifier"));
     } else {
-        declarator->variable_name = &next();
+        declarator->variable_name = tokens.retain(next());
     }
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete declarator;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return declarator;
 }
 
 
-AST* Parser::parseExpression(void) {
-    return parseAssignment();
-}
-
-AST* Parser::parseAssignment(void) {
-    Expression* expression = (Expression*) parseBooleanOR();
-
-    while (
-        match(TokenType::ASSIGNMENT_ASSIGN)
-        || match(TokenType::ASSIGNMENT_OP_ADD)
-        || match(TokenType::ASSIGNMENT_OP_SUB)
-        || match(TokenType::ASSIGNMENT_OP_MUL)
-        || match(TokenType::ASSIGNMENT_OP_DIV)
-        || match(TokenType::ASSIGNMENT_OP_MOD)
-        || match(TokenType::ASSIGNMENT_OP_OR)
-        || match(TokenType::ASSIGNMENT_OP_XOR)
-        || match(TokenType::ASSIGNMENT_OP_AND)
-        || match(TokenType::ASSIGNMENT_OP_LEFT_SHIFT)
-        || match(TokenType::ASSIGNMENT_OP_RIGHT_SHIFT)
-    ) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBooleanOR()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBooleanOR(void) {
-    Expression* expression = (Expression*) parseBooleanXOR();
-
-    while (match(TokenType::BOOLEAN_OP_OR)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBooleanXOR()
-        );
-    }
-
-    return expression;
+// How tightly each binary operator binds, as listed in the operator
+// precedence table of `docs/specifications.md`
+static constexpr std::array<Precedence, TOKEN_TYPE_COUNT> buildPrecedences(void) {
+    std::array<Precedence, TOKEN_TYPE_COUNT> precedences = {};
+
+    for (const TokenType type : {
+        TokenType::ASSIGNMENT_ASSIGN,
+        TokenType::ASSIGNMENT_OP_ADD,
+        TokenType::ASSIGNMENT_OP_SUB,
+        TokenType::ASSIGNMENT_OP_MUL,
+        TokenType::ASSIGNMENT_OP_DIV,
+        TokenType::ASSIGNMENT_OP_MOD,
+        TokenType::ASSIGNMENT_OP_OR,
+        TokenType::ASSIGNMENT_OP_XOR,
+        TokenType::ASSIGNMENT_OP_AND,
+        TokenType::ASSIGNMENT_OP_LEFT_SHIFT,
+        TokenType::ASSIGNMENT_OP_RIGHT_SHIFT
+    }) {
+        precedences[(uint32_t) type] = Precedence::ASSIGNMENT;
+    }
+
+    precedences[(uint32_t) TokenType::BOOLEAN_OP_OR] = Precedence::BOOLEAN_OR;
+    precedences[(uint32_t) TokenType::BOOLEAN_OP_XOR] = Precedence::BOOLEAN_XOR;
+    precedences[(uint32_t) TokenType::BOOLEAN_OP_AND] = Precedence::BOOLEAN_AND;
+    precedences[(uint32_t) TokenType::BITWISE_OP_OR] = Precedence::BITWISE_OR;
+    precedences[(uint32_t) TokenType::BITWISE_OP_XOR] = Precedence::BITWISE_XOR;
+    precedences[(uint32_t) TokenType::BITWISE_OP_AND] = Precedence::BITWISE_AND;
+
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_EQUALITY] = Precedence::EQUALITY;
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_INEQUALITY] = Precedence::EQUALITY;
+
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_LESS_THAN] = Precedence::RELATIONAL;
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_GREATER_THAN] = Precedence::RELATIONAL;
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_LESS_THAN_EQUAL] = Precedence::RELATIONAL;
+    precedences[(uint32_t) TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL] = Precedence::RELATIONAL;
+
+    precedences[(uint32_t) TokenType::BITWISE_OP_LEFT_SHIFT] = Precedence::BITWISE_SHIFT;
+    precedences[(uint32_t) TokenType::BITWISE_OP_RIGHT_SHIFT] = Precedence::BITWISE_SHIFT;
+
+    precedences[(uint32_t) TokenType::ARITHMETIC_OP_ADD] = Precedence::ADDITIVE;
+    precedences[(uint32_t) TokenType::ARITHMETIC_OP_SUB] = Precedence::ADDITIVE;
+
+    precedences[(uint32_t) TokenType::ARITHMETIC_OP_MUL] = Precedence::MULTIPLICATIVE;
+    precedences[(uint32_t) TokenType::ARITHMETIC_OP_DIV] = Precedence::MULTIPLICATIVE;
+    precedences[(uint32_t) TokenType::ARITHMETIC_OP_MOD] = Precedence::MULTIPLICATIVE;
+
+    return precedences;
 }
 
-AST* Parser::parseBooleanXOR(void) {
-    Expression* expression = (Expression*) parseBooleanAND();
+static constexpr std::array<Precedence, TOKEN_TYPE_COUNT> precedences = buildPrecedences();
 
-    while (match(TokenType::BOOLEAN_OP_XOR)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBooleanAND()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBooleanAND(void) {
-    Expression* expression = (Expression*) parseBitwiseOR();
-
-    while (match(TokenType::BOOLEAN_OP_AND)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBitwiseOR()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBitwiseOR(void) {
-    Expression* expression = (Expression*) parseBitwiseXOR();
-
-    while (match(TokenType::BITWISE_OP_OR)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBitwiseXOR()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBitwiseXOR(void) {
-    Expression* expression = (Expression*) parseBitwiseAND();
-    
-    while (match(TokenType::BITWISE_OP_XOR)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBitwiseAND()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBitwiseAND(void) {
-    Expression* expression = (Expression*) parseEquality();
-
-    while (match(TokenType::BITWISE_OP_AND)) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseEquality()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseEquality(void) {
-    Expression* expression = (Expression*) parseRelational();
-    
-    while (
-        match(TokenType::RELATIONAL_OP_EQUALITY)
-        || match(TokenType::RELATIONAL_OP_INEQUALITY)
-    ) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseRelational()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseRelational(void) {
-    Expression* expression = (Expression*) parseBitwiseShift();
-
-    while (
-        match(TokenType::RELATIONAL_OP_LESS_THAN)
-        || match(TokenType::RELATIONAL_OP_GREATER_THAN)
-        || match(TokenType::RELATIONAL_OP_LESS_THAN_EQUAL)
-        || match(TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL)
-    ) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseBitwiseShift()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseBitwiseShift(void) {
-    Expression* expression = (Expression*) parseAdditive();
-
-    while (
-        match(TokenType::BITWISE_OP_LEFT_SHIFT)
-        || match(TokenType::BITWISE_OP_RIGHT_SHIFT)
-    ) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseAdditive()
-        );
-    }
-
-    return expression;
-}
-
-AST* Parser::parseAdditive(void) {
-    Expression* expression = (Expression*) parseMultiplicative();
-
-    while (
-        match(TokenType::ARITHMETIC_OP_ADD)
-        || match(TokenType::ARITHMETIC_OP_SUB)
-    ) {
-        OperatorToken* _operator = &next();
-        expression = newBinaryExpression(
-            _operator,
-            expression,
-            (Expression*) parseMultiplicative()
-        );
-    }
-
-    return expression;
+AST* Parser::parseExpression(void) {
+    return parseBinary(Precedence::ASSIGNMENT);
 }
 
-AST* Parser::parseMultiplicative(void) {
+AST* Parser::parseBinary(const Precedence minimum) {
     Expression* expression = (Expression*) parsePrefix();
 
-    while (
-        match(TokenType::ARITHMETIC_OP_MUL)
-        || match(TokenType::ARITHMETIC_OP_DIV)
-        || match(TokenType::ARITHMETIC_OP_MOD)
+    // Operators binding at least as tight as `minimum` are folded into the
+    // left operand, every level being left associative (assignment too).
+    // The right operand only takes the operators binding tighter than this one.
+    for (
+        Precedence precedence = precedences[(uint32_t) tokens.type(position)];
+        precedence != Precedence::NONE && precedence >= minimum;
+        precedence = precedences[(uint32_t) tokens.type(position)]
     ) {
-        OperatorToken* _operator = &next();
+        OperatorToken* _operator = tokens.retain(next());
         expression = newBinaryExpression(
+            arena,
             _operator,
             expression,
-            (Expression*) parsePrefix()
+            (Expression*) parseBinary((Precedence) ((uint8_t) precedence + 1))
         );
     }
 
@@ -929,8 +889,8 @@ AST* Parser::parsePrefix(void) {
         || match(TokenType::BITWISE_OP_COMPLEMENT)
         || match(TokenType::BITWISE_OP_AND)
     ) {
-        OperatorToken* _operator = &next();
-        return newPrefixExpression(_operator, (Expression*) parsePostfix());
+        OperatorToken* _operator = tokens.retain(next());
+        return newPrefixExpression(arena, _operator, (Expression*) parsePostfix());
     }
 
     return parsePostfix();
@@ -945,41 +905,34 @@ AST* Parser::parsePostfix(void) {
         || match(TokenType::PUNCTUATION_LEFT_BRACKET)
     ) {
         if (consumeIf(TokenType::PUNCTUATION_DOT)) {
-            MemberAccess* member_access = new MemberAccess;
-            ErrorNode* errors = new ErrorNode;
+            MemberAccess* member_access = arena.make<MemberAccess>();
+            ErrorNode errors;
 
             member_access->owner = expression;
             if (ErrorNode* error_in_owner = get_node_if(member_access->owner, ErrorNode)) {
                 member_access->owner = nullptr;
-                errors->appendError(error_in_owner);
+                errors.appendError(error_in_owner);
             }
 
             if (!match(TokenType::IDENTIFIER)) {
-                errors->appendError(error("expected identifier"));
+                errors.appendError(error("expected identifier"));
             } else {
-                member_access->member = &next(); 
+                member_access->member = tokens.retain(next()); 
             }
 
-            if (ErrorNode* errors_found = errors->additional_errors) {
-                if (errors_found == nullptr) {
-                    delete errors;
-                } else {
-                    errors->additional_errors = nullptr;
-                    delete errors;
-                    delete member_access;
-                    member_access = (MemberAccess*) errors_found;
-                }
+            if (ErrorNode* errors_found = errors.additional_errors) {
+                member_access = (MemberAccess*) errors_found;
             }
 
             expression = member_access;
         } else if (consumeIf(TokenType::PUNCTUATION_LEFT_PARENTHESIS)) {
-            FunctionCall* function_call = new FunctionCall;
-            ErrorNode* errors = new ErrorNode;
+            FunctionCall* function_call = arena.make<FunctionCall>();
+            ErrorNode errors;
 
             function_call->function = expression;
             if (ErrorNode* error_in_function = get_node_if(function_call->function, ErrorNode)) {
                 function_call->function = nullptr;
-                errors->appendError(error_in_function);
+                errors.appendError(error_in_function);
             }
 
             if (!consumeIf(TokenType::PUNCTUATION_RIGHT_PARENTHESIS)) {
@@ -987,55 +940,41 @@ AST* Parser::parsePostfix(void) {
 
                 if (ErrorNode* error_in_arguments = get_node_if(function_call->arguments, ErrorNode)) {
                     function_call->arguments = nullptr;
-                    errors->appendError(error_in_arguments);
+                    errors.appendError(error_in_arguments);
                 }
 
                 if (!consumeIf(TokenType::PUNCTUATION_RIGHT_PARENTHESIS)) {
-                    errors->appendError(error("expected `)`"));
+                    errors.appendError(error("expected `)`"));
                 }
             }
 
-            if (ErrorNode* errors_found = errors->additional_errors) {
-                if (errors_found == nullptr) {
-                    delete errors;
-                } else {
-                    errors->additional_errors = nullptr;
-                    delete errors;
-                    delete function_call;
-                    function_call = (FunctionCall*) errors_found;
-                }
+            if (ErrorNode* errors_found = errors.additional_errors) {
+                function_call = (FunctionCall*) errors_found;
             }
 
             expression = function_call;
         } else if (consumeIf(TokenType::PUNCTUATION_LEFT_BRACKET)) {
-            ArrayAccess* array_access = new ArrayAccess;
-            ErrorNode* errors = new ErrorNode;
+            ArrayAccess* array_access = arena.make<ArrayAccess>();
+            ErrorNode errors;
 
             array_access->array = expression;
             if (ErrorNode* error_in_array = get_node_if(array_access->array, ErrorNode)) {
                 array_access->array = nullptr;
-                errors->appendError(error_in_array);
+                errors.appendError(error_in_array);
             }
 
             array_access->index = (Expression*) parseExpression();
             if (ErrorNode* error_in_index = get_node_if(array_access->index, ErrorNode)) {
                 array_access->index = nullptr;
-                errors->appendError(error_in_index);
+                errors.appendError(error_in_index);
             }
 
             if (!consumeIf(TokenType::PUNCTUATION_RIGHT_BRACKET)) {
-                errors->appendError(error("expected `]`"));
+                errors.appendError(error("expected `]`"));
             }
 
-            if (ErrorNode* errors_found = errors->additional_errors) {
-                if (errors_found == nullptr) {
-                    delete errors;
-                } else {
-                    errors->additional_errors = nullptr;
-                    delete errors;
-                    delete array_access;
-                    array_access = (ArrayAccess*) errors_found;
-                }
+            if (ErrorNode* errors_found = errors.additional_errors) {
+                array_access = (ArrayAccess*) errors_found;
             }
 
             expression = array_access;
@@ -1048,21 +987,30 @@ AST* Parser::parsePostfix(void) {
         match(TokenType::OP_INCREMENT)
         || match(TokenType::OP_DECREMENT)
     ) {
-        OperatorToken* _operator = &next();
-        expression = newPostfixExpression(_operator, expression);
+        OperatorToken* _operator = tokens.retain(next());
+        expression = newPostfixExpression(arena, _operator, expression);
     }
 
     return expression;
 }
 
 AST* Parser::parsePrimary(void) {
-    return tryParse({
-            &Parser::parseGrouping,
-            &Parser::parseLiteral,
-            &Parser::parseNumberConstant,
-            &Parser::parseIdentifierConstant
-            // ,parseCastExpression TODO
-        }, "expected primary expression");
+    switch (tokens.type(position)) {
+        case TokenType::PUNCTUATION_LEFT_PARENTHESIS:
+            return parsePredicted(&Parser::parseGrouping, "expected primary expression");
+        case TokenType::LITERAL_BOOLEAN_TRUE:
+        case TokenType::LITERAL_BOOLEAN_FALSE:
+        case TokenType::LITERAL_REFERENCE_NULL:
+            return parseLiteral();
+        case TokenType::INTEGER_LITERAL:
+        case TokenType::FLOAT_LITERAL:
+            return parseNumberConstant();
+        case TokenType::IDENTIFIER:
+            return parseIdentifierConstant();
+        // TODO: parseCastExpression
+        default:
+            return error("expected primary expression");
+    }
 }
 
 AST* Parser::parseLiteral(void) {
@@ -1074,9 +1022,9 @@ AST* Parser::parseLiteral(void) {
         return error("expected literal value");
     }
 
-    LiteralExpression* literal = new LiteralExpression;
+    LiteralExpression* literal = arena.make<LiteralExpression>();
 
-    literal->value = &next();
+    literal->value = tokens.retain(next());
 
     return literal;
 }
@@ -1089,9 +1037,9 @@ AST* Parser::parseNumberConstant(void) {
         return error("expected numeric constant");
     }
 
-    NumberConstant* number = new NumberConstant;
+    NumberConstant* number = arena.make<NumberConstant>();
 
-    number->value = &next();
+    number->value = tokens.retain(next());
 
     return number;
 }
@@ -1101,9 +1049,9 @@ AST* Parser::parseIdentifierConstant(void) {
         return error("expected an identifier");
     }
 
-    IdentifierConstant* identifier = new IdentifierConstant;
+    IdentifierConstant* identifier = arena.make<IdentifierConstant>();
 
-    identifier->value = &next();
+    identifier->value = tokens.retain(next());
 
     return identifier;
 }
@@ -1122,7 +1070,6 @@ AST* Parser::parseGrouping(void) {
     }
 
     if (!consumeIf(TokenType::PUNCTUATION_RIGHT_PARENTHESIS)) {
-        delete group;
         return error("expected `)`");
     }
 
@@ -1130,60 +1077,64 @@ AST* Parser::parseGrouping(void) {
 }
 
 AST* Parser::parseExpressionList(void) {
-    ExpressionList* expression_list = new ExpressionList;
-    ErrorNode* errors = new ErrorNode;
+    ExpressionList* expression_list = arena.make<ExpressionList>();
+    ErrorNode errors;
 
     do {
         Expression* expression = (Expression*) parseExpression();
 
         if (ErrorNode* error_in_expression = get_node_if(expression, ErrorNode)) {
-            errors->appendError(error_in_expression);
+            errors.appendError(error_in_expression);
         } else {
             expression_list->expressions.push_back(expression);
         }
     } while (!atEnd() && consumeIf(TokenType::PUNCTUATION_COMMA));
 
-    if (ErrorNode* errors_found = errors->additional_errors) {
-        if (errors_found == nullptr) {
-            delete errors;
-        } else {
-            errors->additional_errors = nullptr;
-            delete errors;
-            delete expression_list;
-            return errors_found;
-        }
+    if (ErrorNode* errors_found = errors.additional_errors) {
+        return errors_found;
     }
 
     return expression_list;
 }
 
-AST* Parser::tryParse(const std::vector<ProductionRule>& rules, const std::string& error_message) {
-    const uint32_t current_position = position;
-
-    ErrorNode* potential_error = nullptr;
+AST* Parser::parsePredicted(const ProductionRule rule, const std::string& error_message) {
+    const uint32_t start = position;
 
-    for (const ProductionRule& rule : rules) {
-        AST* tree = (this->*rule)();
+    AST* tree = (this->*rule)();
 
-        if (ErrorNode* err = get_node_if(tree, ErrorNode)) {
-            if ((err->occurrence > current_position) && (potential_error == nullptr || (err->occurrence > potential_error->occurrence))) {
-                potential_error = err;
-            }
-        } else {
-            return tree;
-        }
+    ErrorNode* err = get_node_if(tree, ErrorNode);
+    if (err == nullptr) {
+        return tree;
+    }
 
-        position = current_position; // reset position to try again
+    // Failing on the very first token means the lookahead was all that
+    // matched, so the construct as a whole is what was expected
+    if (err->occurrence <= start) {
+        position = start;
+        err = error(error_message);
     }
 
-    // All rules failed
-    ErrorNode* result_error = (potential_error != nullptr) ? potential_error : error(error_message);
-    position = result_error->occurrence;
+    position = err->occurrence;
 
-    return result_error;
+    return err;
 }
 
-std::unique_ptr<Program> Parser::getProgramTree(const std::unique_ptr<Module>& module) {
+Program* Parser::getProgramTree(const std::unique_ptr<Module>& module) {
     Parser parser(module);
-    return parser.has_error ? none() : some(std::move(parser.program));
+    return parser.has_error ? none() : some(parser.program);
+}
+
+std::unique_ptr<FlatTree> Parser::getFlatTree(const std::unique_ptr<Module>& module) {
+    std::unique_ptr<FlatTree> tree = std::make_unique<FlatTree>();
+    Arena scratch;
+
+    // The flat tree refers to tokens by their index in the stream, so it is
+    // parsed from the materialized tokens, on one thread
+    Parser parser(module, scratch);
+    parser.flat = tree.get();
+    parser.parse(UINT32_MAX);
+
+    std::cerr << parser.reports;
+
+    return parser.has_error ? none() : some(std::move(tree));
 }
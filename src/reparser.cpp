@@ -0,0 +1,420 @@
+/// *==============================================================*
+///  reparser.cpp
+/// *==============================================================*
+#include "include/reparser.hpp"
+#include "include/tokenizer.hpp"
+#include "include/parser.hpp"
+
+#include <algorithm>
+
+using namespace XC;
+
+Reparser::Reparser(const std::unique_ptr<Module>& module, const Edit& edit)
+    : module(module),
+      edit(edit),
+      previous_source(std::move(module->source)),
+      previous_tokens(std::move(module->tokens)),
+      byte_shift((int64_t) edit.replacement.size() - (edit.end - edit.begin)),
+      token_shift(0),
+      line_shift(0) {
+    const std::string_view content = previous_source->content;
+
+    std::string text;
+    text.reserve(content.size() + byte_shift);
+    text.append(content.substr(0, edit.begin));
+    text.append(edit.replacement);
+    text.append(content.substr(edit.end));
+
+    module->source = SourceFile::fromText(previous_source->filename, std::move(text));
+
+    const std::string_view replaced = content.substr(edit.begin, edit.end - edit.begin);
+    line_shift = std::count(edit.replacement.begin(), edit.replacement.end(), '\n') - std::count(replaced.begin(), replaced.end(), '\n');
+}
+
+Edit Edit::between(const std::string_view before, const std::string_view after) {
+    const uint32_t shorter = min_of(before.size(), after.size());
+
+    uint32_t prefix = 0;
+    while (prefix < shorter && before[prefix] == after[prefix]) {
+        ++prefix;
+    }
+
+    uint32_t suffix = 0;
+    while (suffix < shorter - prefix && before[before.size() - 1 - suffix] == after[after.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    return {prefix, (uint32_t) before.size() - suffix, after.substr(prefix, after.size() - suffix - prefix)};
+}
+
+bool Reparser::applyEdit(const std::unique_ptr<Module>& module, const Edit& edit) {
+    if (edit.begin > edit.end || edit.end > module->source->content.size()) {
+        std::cerr << "xc: \033[31merror\033[0m: edit is out of range: `" << module->source->filename << '`' << std::endl;
+        return false;
+    }
+
+    // Refers to declarations that may be replaced
+    module->symbols = nullptr;
+
+    Reparser reparser(module, edit);
+
+    if (reparser.previous_tokens == nullptr || module->program == nullptr) {
+        return reparser.parseAgain();
+    }
+
+    const bool parsed = reparser.reparse();
+
+    // Names are views as well, and the previous source goes away with the reparser
+    reparser.relocateNames();
+
+    return parsed;
+}
+
+bool Reparser::reparse(void) {
+    const TokenStream& tokens = *previous_tokens;
+    const ArenaList<Declaration*>& declarations = module->program->declarations;
+
+    // Declaration k spans the tokens [starts[k], starts[k + 1]). In a
+    // program that parsed, each one ends on the `}` closing its outermost
+    // brace, and END_OF_FILE follows the last one.
+    std::vector<uint32_t> starts = {0};
+    {
+        uint32_t depth = 0;
+
+        for (uint32_t index = 0; index + 1 < tokens.size(); ++index) {
+            if (tokens.type(index) == TokenType::PUNCTUATION_LEFT_BRACE) {
+                ++depth;
+            } else if (tokens.type(index) == TokenType::PUNCTUATION_RIGHT_BRACE && --depth == 0) {
+                starts.push_back(index + 1);
+            }
+        }
+    }
+
+    const uint32_t count = declarations.size();
+
+    if (starts.size() != count + 1 || starts.back() + 1 != tokens.size()) {
+        return parseAgain();
+    }
+
+    const auto startOf = [&](const uint32_t k) {
+        return tokens.offset(starts[k]);
+    };
+
+    const auto endOf = [&](const uint32_t k) {
+        return tokens.offset(starts[k + 1] - 1) + (uint32_t) tokens.lexeme(starts[k + 1] - 1).size();
+    };
+
+    // Declarations merely touching the edit are reparsed too, the edit may
+    // join its text to their first or last token
+    uint32_t first = 0;
+    while (first < count && endOf(first) < edit.begin) {
+        ++first;
+    }
+
+    uint32_t after = first;
+    while (after < count && startOf(after) <= edit.end) {
+        ++after;
+    }
+
+    // The text from the end of the last declaration kept before the edit to
+    // the start of the first one kept after it is lexed again. Both ends are
+    // token boundaries in the edited source as well.
+    const uint32_t from = first > 0 ? endOf(first - 1) : 0;
+    const uint32_t to = after < count ? startOf(after) + byte_shift : module->source->content.size();
+
+    Tokenizer tokenizer(module, module->names, from, to);
+    tokenizer.tokenize();
+
+    if (tokenizer.has_error) {
+        module->program = nullptr;
+        return false;
+    }
+
+    // A comment opened by the edit runs into the declarations after it
+    if (after < count && tokenizer.cursor - tokenizer.begin != to) {
+        return parseAgain();
+    }
+
+    const TokenStream& relexed = *tokenizer.tokens;
+
+    token_shift = (int64_t) relexed.size() - (starts[after] - starts[first]);
+
+    module->tokens = std::make_unique<TokenStream>(*module->source);
+    module->tokens->reserve(tokens.size() + token_shift + 1);
+    module->tokens->appendShifted(tokens, 0, starts[first], 0);
+    module->tokens->appendShifted(relexed, 0, relexed.size(), 0);
+
+    if (after < count) {
+        module->tokens->appendShifted(tokens, starts[after], tokens.size(), byte_shift);
+    } else {
+        module->tokens->append(TokenType::END_OF_FILE, tokenizer.cursor - tokenizer.begin, 0, NO_SYMBOL);
+    }
+
+    const auto shiftedStartOf = [&](const uint32_t k) {
+        return (uint32_t) (starts[k] + token_shift);
+    };
+
+    // Parsing goes on until it stops where a kept declaration starts. It
+    // only runs past the relexed tokens when the edit left a declaration
+    // open or error recovery skipped ahead.
+    Parser parser(module, module->arena);
+    parser.position = starts[first];
+
+    uint32_t kept = after;
+    for (;;) {
+        parser.parse(kept < count ? shiftedStartOf(kept) : UINT32_MAX);
+
+        while (kept < count && shiftedStartOf(kept) < parser.position) {
+            ++kept;
+        }
+
+        if (kept == count) {
+            parser.parse(UINT32_MAX);
+            break;
+        }
+
+        if (shiftedStartOf(kept) == parser.position) {
+            break;
+        }
+    }
+
+    std::cerr << parser.reports;
+
+    if (parser.has_error) {
+        module->program = nullptr;
+        return false;
+    }
+
+    Program* program = module->arena.make<Program>();
+
+    for (uint32_t k = 0; k < first; ++k) {
+        relocate(declarations[k], false);
+        program->declarations.push_back(declarations[k]);
+    }
+
+    for (Declaration* declaration : parser.program->declarations) {
+        program->declarations.push_back(declaration);
+    }
+
+    for (uint32_t k = kept; k < count; ++k) {
+        relocate(declarations[k], true);
+        program->declarations.push_back(declarations[k]);
+    }
+
+    module->program = program;
+
+    return true;
+}
+
+bool Reparser::parseAgain(void) {
+    // Nothing from before the edit is kept, so everything it was made of goes
+    module->program = nullptr;
+    module->tokens = nullptr;
+    module->names = Interner();
+    module->types.clear();
+    module->arena.clear();
+
+    if ((module->tokens = Tokenizer::extractTokenStream(module)) == nullptr) {
+        return false;
+    }
+
+    return (module->program = Parser::getProgramTree(module)) != nullptr;
+}
+
+void Reparser::relocate(Token* token, const bool after_edit) {
+    if (token == nullptr) {
+        return;
+    }
+
+    // Every token is retained by the one node referencing it, so it is moved once
+    token->lexeme = relocate(token->lexeme);
+
+    if (after_edit) {
+        token->index += token_shift;
+        token->line += line_shift;
+
+        // Only the tokens on the line the edit ends on move sideways, but the
+        // column of every token after the edit is worked out again, which
+        // costs no more than telling them apart
+        if (token->line < module->source->lineCount()) {
+            token->column = token->lexeme.data() - module->source->content.data() - module->source->line_offsets[token->line];
+        }
+    }
+}
+
+std::string_view Reparser::relocate(const std::string_view text) {
+    const std::string_view content = previous_source->content;
+
+    if (text.data() < content.data() || text.data() > content.data() + content.size()) {
+        return text; // not from the source
+    }
+
+    const uint32_t offset = text.data() - content.data();
+
+    if (offset + text.size() <= edit.begin) {
+        return module->source->content.substr(offset, text.size());
+    }
+
+    if (offset >= edit.end) {
+        return module->source->content.substr(offset + byte_shift, text.size());
+    }
+
+    return module->arena.copy(text);
+}
+
+void Reparser::relocateNames(void) {
+    for (SymbolId id = 0; id < module->names.size(); ++id) {
+        const std::string_view name = module->names.name(id);
+        const std::string_view moved = relocate(name);
+
+        if (moved.data() != name.data()) {
+            module->names.rebind(id, moved);
+        }
+    }
+}
+
+void Reparser::relocate(AST* node, const bool after_edit) {
+    if (node == nullptr) {
+        return;
+    }
+
+    // The analyzer trusts a type it already worked out, but one derived
+    // before the edit may have changed along with a declaration it used
+    if (node->type() >= ASTType::PrefixUnaryExpression && node->type() <= ASTType::ArrayAccess) {
+        ((Expression*) node)->evaluated_type = nullptr;
+    }
+
+    switch (node->type()) {
+        case ASTType::Function: {
+            Function* function = (Function*) node;
+            relocate(function->owner, after_edit);
+            relocate(function->return_type, after_edit);
+            relocate(function->name, after_edit);
+            relocate(function->parameters, after_edit);
+            relocate(function->body, after_edit);
+            break;
+        }
+        case ASTType::Structure: {
+            Structure* structure = (Structure*) node;
+            relocate(structure->name, after_edit);
+            relocate(structure->members, after_edit);
+            break;
+        }
+        case ASTType::DataType:
+            relocate(((DataType*) node)->type_name, after_edit);
+            break;
+        case ASTType::VariableDeclarator: {
+            VariableDeclarator* declarator = (VariableDeclarator*) node;
+            relocate(declarator->data_type, after_edit);
+            relocate(declarator->variable_name, after_edit);
+            break;
+        }
+        case ASTType::StructureMembers:
+            for (VariableDeclarator* member : ((StructureMembers*) node)->members) {
+                relocate(member, after_edit);
+            }
+            break;
+        case ASTType::ParameterList:
+            for (VariableDeclarator* parameter : ((ParameterList*) node)->parameters) {
+                relocate(parameter, after_edit);
+            }
+            break;
+        case ASTType::BlockStatement:
+            for (Statement* statement : ((BlockStatement*) node)->statements) {
+                relocate(statement, after_edit);
+            }
+            break;
+        case ASTType::ExpressionList:
+            for (Expression* expression : ((ExpressionList*) node)->expressions) {
+                relocate(expression, after_edit);
+            }
+            break;
+        case ASTType::VariableDeclarationStatement: {
+            VariableDeclarationStatement* statement = (VariableDeclarationStatement*) node;
+            relocate(statement->declarator, after_edit);
+            relocate(statement->initial, after_edit);
+            break;
+        }
+        case ASTType::ExpressionStatement:
+            relocate(((ExpressionStatement*) node)->expression, after_edit);
+            break;
+        case ASTType::ConditionalStatement: {
+            ConditionalStatement* conditional = (ConditionalStatement*) node;
+            relocate(conditional->condition, after_edit);
+            relocate(conditional->body, after_edit);
+            relocate(conditional->else_case, after_edit);
+            break;
+        }
+        case ASTType::ReturnStatement:
+            relocate(((ReturnStatement*) node)->expression, after_edit);
+            break;
+        case ASTType::WhileIteration: {
+            WhileIteration* iteration = (WhileIteration*) node;
+            relocate(iteration->condition, after_edit);
+            relocate(iteration->body, after_edit);
+            break;
+        }
+        case ASTType::ForIteration: {
+            ForIteration* iteration = (ForIteration*) node;
+            relocate(iteration->initial, after_edit);
+            relocate(iteration->condition, after_edit);
+            relocate(iteration->update, after_edit);
+            relocate(iteration->body, after_edit);
+            break;
+        }
+        case ASTType::PrefixUnaryExpression: {
+            PrefixUnaryExpression* expression = (PrefixUnaryExpression*) node;
+            relocate(expression->operation, after_edit);
+            relocate(expression->operand, after_edit);
+            break;
+        }
+        case ASTType::PostfixUnaryExpression: {
+            PostfixUnaryExpression* expression = (PostfixUnaryExpression*) node;
+            relocate(expression->operation, after_edit);
+            relocate(expression->operand, after_edit);
+            break;
+        }
+        case ASTType::BinaryExpression: {
+            BinaryExpression* expression = (BinaryExpression*) node;
+            relocate(expression->operation, after_edit);
+            relocate(expression->left_operand, after_edit);
+            relocate(expression->right_operand, after_edit);
+            break;
+        }
+        case ASTType::LiteralExpression:
+            relocate(((LiteralExpression*) node)->value, after_edit);
+            break;
+        case ASTType::NumberConstant:
+            relocate(((NumberConstant*) node)->value, after_edit);
+            break;
+        case ASTType::IdentifierConstant:
+            relocate(((IdentifierConstant*) node)->value, after_edit);
+            break;
+        case ASTType::MemberAccess: {
+            MemberAccess* access = (MemberAccess*) node;
+            relocate(access->owner, after_edit);
+            relocate(access->member, after_edit);
+            break;
+        }
+        case ASTType::FunctionCall: {
+            FunctionCall* call = (FunctionCall*) node;
+            relocate(call->function, after_edit);
+            relocate(call->arguments, after_edit);
+            break;
+        }
+        case ASTType::ArrayAccess: {
+            ArrayAccess* access = (ArrayAccess*) node;
+            relocate(access->array, after_edit);
+            relocate(access->index, after_edit);
+            break;
+        }
+        case ASTType::CastExpression: {
+            CastExpression* cast = (CastExpression*) node;
+            relocate(cast->data_type, after_edit);
+            relocate(cast->expression, after_edit);
+            break;
+        }
+        default:
+            break;
+    }
+}
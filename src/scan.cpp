@@ -0,0 +1,183 @@
+/// *==============================================================*
+///  scan.cpp
+/// *==============================================================*
+#include "include/scan.hpp"
+#include "include/cclass.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#include <immintrin.h>
+#define XC_HAS_X86_SIMD 1
+#endif
+
+using namespace XC;
+
+// <*> ================================================================ <*>
+//  scalar
+
+static const char* skipWhitespaceScalar(const char* begin, const char* end) {
+    while (begin < end && isWhitespace(*begin)) {
+        ++begin;
+    }
+
+    return begin;
+}
+
+static const char* skipIdentifierScalar(const char* begin, const char* end) {
+    while (begin < end && isIdentifierCharacter(*begin)) {
+        ++begin;
+    }
+
+    return begin;
+}
+
+#ifdef XC_HAS_X86_SIMD
+
+// Both classifiers set a lane to 0xFF when the byte belongs to the class.
+// Range checks use `min(x - low, span) == x - low`, the unsigned
+// `x - low <= span` that SSE2 has no direct instruction for.
+
+// <*> ================================================================ <*>
+//  SSE2
+
+static inline __m128i whitespaceLanes(const __m128i bytes) {
+    const __m128i control = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+    const __m128i is_control = _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8('\r' - '\t')), control);
+    const __m128i is_space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+
+    return _mm_or_si128(is_control, is_space);
+}
+
+static inline __m128i identifierLanes(const __m128i bytes) {
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8('z' - 'a')), letter);
+    const __m128i digit = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8('9' - '0')), digit);
+    const __m128i is_underscore = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'));
+
+    return _mm_or_si128(_mm_or_si128(is_letter, is_digit), is_underscore);
+}
+
+template <__m128i (*lanes)(const __m128i), const char* (*scalar)(const char*, const char*)>
+static const char* skipSSE2(const char* begin, const char* end) {
+    while (end - begin >= 16) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*) begin);
+        const uint32_t outside = ~_mm_movemask_epi8(lanes(bytes)) & 0xFFFF;
+
+        if (outside != 0) {
+            return begin + __builtin_ctz(outside);
+        }
+
+        begin += 16;
+    }
+
+    return scalar(begin, end);
+}
+
+// <*> ================================================================ <*>
+//  AVX2
+
+__attribute__((target("avx2")))
+static inline __m256i whitespaceLanes(const __m256i bytes) {
+    const __m256i control = _mm256_sub_epi8(bytes, _mm256_set1_epi8('\t'));
+    const __m256i is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(control, _mm256_set1_epi8('\r' - '\t')), control);
+    const __m256i is_space = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+
+    return _mm256_or_si256(is_control, is_space);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i identifierLanes(const __m256i bytes) {
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(bytes, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8('z' - 'a')), letter);
+    const __m256i digit = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8('9' - '0')), digit);
+    const __m256i is_underscore = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('_'));
+
+    return _mm256_or_si256(_mm256_or_si256(is_letter, is_digit), is_underscore);
+}
+
+template <__m256i (*lanes)(const __m256i), const char* (*tail)(const char*, const char*)>
+__attribute__((target("avx2")))
+static const char* skipAVX2(const char* begin, const char* end) {
+    while (end - begin >= 32) {
+        const __m256i bytes = _mm256_loadu_si256((const __m256i*) begin);
+        const uint32_t outside = ~(uint32_t) _mm256_movemask_epi8(lanes(bytes));
+
+        if (outside != 0) {
+            return begin + __builtin_ctz(outside);
+        }
+
+        begin += 32;
+    }
+
+    return tail(begin, end);
+}
+
+#endif
+
+// <*> ================================================================ <*>
+
+static const Scan::Scanners scalar_scanners = {
+    skipWhitespaceScalar,
+    skipIdentifierScalar
+};
+
+#ifdef XC_HAS_X86_SIMD
+static const Scan::Scanners sse2_scanners = {
+    skipSSE2<whitespaceLanes, skipWhitespaceScalar>,
+    skipSSE2<identifierLanes, skipIdentifierScalar>
+};
+
+static const Scan::Scanners avx2_scanners = {
+    skipAVX2<whitespaceLanes, skipSSE2<whitespaceLanes, skipWhitespaceScalar>>,
+    skipAVX2<identifierLanes, skipSSE2<identifierLanes, skipIdentifierScalar>>
+};
+#endif
+
+Scan::Level Scan::supported(void) {
+#ifdef XC_HAS_X86_SIMD
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return Level::AVX2;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return Level::SSE2;
+    }
+#endif
+
+    return Level::SCALAR;
+}
+
+const Scan::Scanners& Scan::at(const Level level) {
+    const Level available = min_of(level, supported());
+
+#ifdef XC_HAS_X86_SIMD
+    switch (available) {
+        case Level::AVX2:
+            return avx2_scanners;
+        case Level::SSE2:
+            return sse2_scanners;
+        default:
+            break;
+    }
+#else
+    (void) available;
+#endif
+
+    return scalar_scanners;
+}
+
+const Scan::Scanners& Scan::scanners = Scan::at(Scan::supported());
+
+const char* Scan::levelName(const Level level) {
+    switch (level) {
+        case Level::AVX2:
+            return "avx2";
+        case Level::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
@@ -3,40 +3,213 @@
 /// *==============================================================*
 #include "include/sourcefile.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define XC_HAS_MMAP 1
+#endif
+
 using namespace XC;
 
-void SourceFile::writeOut(void) {
-    std::ofstream outfile(filename);
+SourceFile::SourceFile(void)
+    : filename(),
+      content(),
+      line_offsets(),
+      buffer(),
+      mapping(nullptr),
+      mapping_size(0) {}
+
+SourceFile::~SourceFile() {
+#ifdef XC_HAS_MMAP
+    if (mapping != nullptr) {
+        munmap(mapping, mapping_size);
+    }
+#endif
+}
+
+uint32_t SourceFile::lineCount(void) const {
+    return line_offsets.size();
+}
+
+std::string_view SourceFile::lineAt(const uint32_t line) const {
+    const uint32_t begin = line_offsets.at(line);
+    const uint32_t end = (line + 1 < line_offsets.size()) ? line_offsets[line + 1] : content.size();
+
+    return content.substr(begin, end - begin);
+}
+
+void SourceFile::appendLine(const std::string& line) {
+    line_offsets.push_back(buffer.size());
+
+    buffer.append(line);
+    buffer.push_back('\n');
+
+    content = buffer;
+}
+
+void SourceFile::appendLines(const std::string_view lines) {
+    for (size_t start = 0; start < lines.size(); start = lines.find('\n', start) + 1) {
+        line_offsets.push_back(buffer.size() + start);
+    }
+
+    buffer.append(lines);
+
+    content = buffer;
+}
+
+bool SourceFile::writeOut(void) {
+    std::ifstream infile(filename, std::ios::binary | std::ios::ate);
+
+    if (infile && (size_t) infile.tellg() == content.size()) {
+        std::string existing(content.size(), '\0');
 
-    for (const std::string& line : content) {
-        outfile << line << '\n';
+        infile.seekg(0);
+        infile.read(existing.data(), existing.size());
+
+        if (infile && existing == content) {
+            return false;
+        }
     }
 
+    infile.close();
+
+    std::ofstream outfile(filename, std::ios::binary);
+
+    outfile.write(content.data(), content.size());
+
     outfile.flush();
     outfile.close();
+
+    return true;
 }
 
-std::unique_ptr<XC::SourceFile> XC::SourceFile::loadContent(const std::string filepath) {
-    std::ifstream infile(filepath);
+void SourceFile::indexLines(void) {
+    const char* const begin = content.data();
+    const char* const end = begin + content.size();
 
-    if (!infile.is_open()) {
-        std::cerr << "xc: \033[31merror\033[0m: " << std::strerror(errno) << ": `" << filepath << '`' << std::endl;
-        return none();
+    line_offsets.clear();
+    line_offsets.reserve(std::count(begin, end, '\n'));
+
+    const char* line = begin;
+    while (line < end) {
+        line_offsets.push_back(line - begin);
+
+        const char* newline = (const char*) std::memchr(line, '\n', end - line);
+        line = newline + 1;
     }
+}
+
+static std::nullptr_t loadError(const std::string& message, const std::string& filepath) {
+    std::cerr << "xc: \033[31merror\033[0m: " << message << ": `" << filepath << '`' << std::endl;
+    return nullptr;
+}
 
+std::unique_ptr<XC::SourceFile> XC::SourceFile::loadContent(const std::string filepath) {
     std::unique_ptr<XC::SourceFile> source_file = std::make_unique<XC::SourceFile>();
     source_file->filename = filepath;
 
-    std::string line;
-    while (std::getline(infile, line)) {
-        line.push_back('\n');
-        source_file->content.push_back(line);
+    // Map the file (or read it in one go) into a single buffer. A missing
+    // `\n` on the last line is added so every line ends the same way.
+#ifdef XC_HAS_MMAP
+    const int fd = open(filepath.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return loadError(std::strerror(errno), filepath);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        return loadError(std::strerror(error), filepath);
+    }
+
+    const size_t size = info.st_size;
+
+    if (size > UINT32_MAX) {
+        close(fd);
+        return loadError("file is too large", filepath);
+    }
+
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            close(fd);
+            return loadError(std::strerror(error), filepath);
+        }
+
+        const char* data = (const char*) mapping;
+
+        if (data[size - 1] == '\n') {
+            madvise(mapping, size, MADV_SEQUENTIAL);
+
+            source_file->mapping = mapping;
+            source_file->mapping_size = size;
+            source_file->content = std::string_view(data, size);
+        } else {
+            source_file->buffer.reserve(size + 1);
+            source_file->buffer.assign(data, size);
+            source_file->buffer.push_back('\n');
+            source_file->content = source_file->buffer;
+
+            munmap(mapping, size);
+        }
+    }
+
+    close(fd);
+#else
+    std::ifstream infile(filepath, std::ios::binary | std::ios::ate);
+
+    if (!infile.is_open()) {
+        return loadError(std::strerror(errno), filepath);
+    }
+
+    const size_t size = infile.tellg();
+
+    if (size > UINT32_MAX) {
+        return loadError("file is too large", filepath);
+    }
+
+    if (size > 0) {
+        source_file->buffer.resize(size);
+        infile.seekg(0);
+        infile.read(&source_file->buffer[0], size);
+
+        if (source_file->buffer.back() != '\n') {
+            source_file->buffer.push_back('\n');
+        }
+
+        source_file->content = source_file->buffer;
     }
 
     infile.close();
+#endif
+
+    source_file->indexLines();
 
     return some(source_file);
-}
\ No newline at end of file
+}
+
+std::unique_ptr<XC::SourceFile> XC::SourceFile::fromText(const std::string filename, std::string text) {
+    std::unique_ptr<XC::SourceFile> source_file = std::make_unique<XC::SourceFile>();
+    source_file->filename = filename;
+    source_file->buffer = std::move(text);
+
+    if (!source_file->buffer.empty() && source_file->buffer.back() != '\n') {
+        source_file->buffer.push_back('\n');
+    }
+
+    source_file->content = source_file->buffer;
+    source_file->indexLines();
+
+    return some(source_file);
+}
@@ -3,82 +3,90 @@
 using namespace XC;
 
 SymbolTable::SymbolTable(void)
-    : symbols(std::unordered_map<std::string, Declaration*>()) {}
+    : symbols(std::unordered_map<SymbolId, Declaration*>()),
+      functions(),
+      structures() {}
 
-Declaration* SymbolTable::lookup(const std::string& identifier) {
-    if (symbols.count(identifier) <= 0) {
-        return nullptr;
-    }
-    return symbols.at(identifier);
+Declaration* SymbolTable::lookup(const SymbolId identifier) {
+    const auto found = symbols.find(identifier);
+    return found == symbols.end() ? nullptr : found->second;
 }
 
-std::vector<Function*> SymbolTable::getAllFunctions(void) {
-    std::vector<Function*> functions;
-    for (const std::pair<std::string, Declaration*> kv : symbols) {
-        if (Function* function = get_node_if(kv.second, Function)) {
-            functions.push_back(function);
-        }
-    }
+const std::vector<Function*>& SymbolTable::getAllFunctions(void) const {
     return functions;
 }
 
-std::vector<Structure*> SymbolTable::getAllStructures(void) {
-    std::vector<Structure*> structures;
-    for (const std::pair<std::string, Declaration*> kv : symbols) {
-        if (Structure* structure = get_node_if(kv.second, Structure)) {
-            structures.push_back(structure);
-        }
-    }
+const std::vector<Structure*>& SymbolTable::getAllStructures(void) const {
     return structures;
 }
 
 bool SymbolTable::loadFunction(Function* function) {
-    if (lookup(function->name->lexeme) == nullptr) {
-        symbols.insert({function->name->lexeme, function});
+    if (symbols.try_emplace(function->name->symbol, function).second) {
+        functions.push_back(function);
         return true;
     }
     return false;
 }
 
 bool SymbolTable::loadStructure(Structure* structure) {
-    if (lookup(structure->name->lexeme) == nullptr) {
-        symbols.insert({structure->name->lexeme, structure});
+    if (symbols.try_emplace(structure->name->symbol, structure).second) {
+        structures.push_back(structure);
         return true;
     }
     return false;
 }
 
-Function* SymbolTable::lookupFunction(const std::string& identifier) {
+Function* SymbolTable::lookupFunction(const SymbolId identifier) {
     return get_node_if(lookup(identifier), Function);
 }
 
-Structure* SymbolTable::lookupStructure(const std::string& identifier) {
+Structure* SymbolTable::lookupStructure(const SymbolId identifier) {
     return get_node_if(lookup(identifier), Structure);
 }
 
-SymbolStack::SymbolStack(void)
-    : stack(std::vector<std::pair<const AST*, std::unordered_map<std::string, const DataType*>>>()) {}
+SymbolStack::SymbolStack(const uint32_t symbol_count)
+    : scopes(),
+      innermost(symbol_count, UNBOUND),
+      bindings() {
+    scopes.reserve(64);
+    bindings.reserve(256);
+}
 
 void SymbolStack::pushStack(const AST* parent) {
-    stack.push_back(std::pair(parent, std::unordered_map<std::string, const DataType*>()));
+    scopes.push_back({parent, (uint32_t) bindings.size()});
 }
 
 void SymbolStack::popStack(void) {
-    stack.pop_back();
-}
+    const uint32_t first_binding = scopes.back().first_binding;
+
+    while (bindings.size() > first_binding) {
+        const Binding& binding = bindings.back();
+        innermost[binding.identifier] = binding.shadowed;
+        bindings.pop_back();
+    }
 
-void SymbolStack::addSymbol(const std::string& identifier, const DataType* type) {
-    stack.back().second.insert({identifier, type});
+    scopes.pop_back();
 }
 
-const DataType* SymbolStack::lookupSymbol(const std::string& identifier) {
-    for (const std::pair<const AST*, std::unordered_map<std::string, const DataType*>>& data : stack) {
-        const std::unordered_map<std::string, const DataType*>& table = data.second;
+void SymbolStack::addSymbol(const SymbolId identifier, const DataType* type) {
+    if (identifier >= innermost.size()) {
+        innermost.resize(identifier + 1, UNBOUND);
+    }
+
+    const uint32_t shadowed = innermost[identifier];
+
+    if (shadowed != UNBOUND && shadowed >= scopes.back().first_binding) {
+        return;
+    }
 
-        if (table.count(identifier) > 0) return {
-            table.at(identifier)
-        };
+    innermost[identifier] = bindings.size();
+    bindings.push_back({identifier, type, shadowed});
+}
+
+const DataType* SymbolStack::lookupSymbol(const SymbolId identifier) const {
+    if (identifier >= innermost.size() || innermost[identifier] == UNBOUND) {
+        return nullptr;
     }
 
-    return nullptr;
+    return bindings[innermost[identifier]].type;
 }
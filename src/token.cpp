@@ -0,0 +1,99 @@
+/// *==============================================================*
+///  token.cpp
+/// *==============================================================*
+#include "include/token.hpp"
+
+#include <algorithm>
+
+using namespace XC;
+
+static_assert((int) TokenType::KEYWORD_ENUM <= UINT8_MAX, "token types must fit in a byte");
+
+TokenStream::TokenStream(const SourceFile& source)
+    : source(source),
+      kinds(),
+      spans(),
+      symbols() {}
+
+void TokenStream::reserve(const size_t capacity) {
+    kinds.reserve(capacity);
+    spans.reserve(capacity);
+    symbols.reserve(capacity);
+}
+
+void TokenStream::resize(const size_t size) {
+    kinds.resize(size);
+    spans.resize(size);
+    symbols.resize(size);
+}
+
+void TokenStream::append(const TokenType type, const uint32_t offset, const uint32_t length, const SymbolId symbol) {
+    kinds.push_back((uint8_t) type);
+    spans.push_back({offset, length});
+    symbols.push_back(symbol);
+}
+
+void TokenStream::place(const TokenStream& from, const uint32_t first, const uint32_t at, const std::vector<SymbolId>& remap) {
+    const uint32_t count = from.size() - first;
+
+    std::copy_n(from.kinds.begin() + first, count, kinds.begin() + at);
+    std::copy_n(from.spans.begin() + first, count, spans.begin() + at);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const SymbolId symbol = from.symbols[first + i];
+        symbols[at + i] = (symbol == NO_SYMBOL || remap.empty()) ? symbol : remap[symbol];
+    }
+}
+
+void TokenStream::appendShifted(const TokenStream& from, const uint32_t first, const uint32_t last, const int64_t shift) {
+    kinds.insert(kinds.end(), from.kinds.begin() + first, from.kinds.begin() + last);
+    symbols.insert(symbols.end(), from.symbols.begin() + first, from.symbols.begin() + last);
+
+    for (uint32_t index = first; index < last; ++index) {
+        spans.push_back({(uint32_t) (from.spans[index].offset + shift), from.spans[index].length});
+    }
+}
+
+uint32_t TokenStream::find(const uint32_t offset) const {
+    return std::partition_point(spans.begin(), spans.end(), [offset](const Span& span) { return span.offset < offset; }) - spans.begin();
+}
+
+std::string_view TokenStream::lexeme(const uint32_t index) const {
+    const Span& span = spans.at(index);
+    return source.content.substr(span.offset, span.length);
+}
+
+uint32_t TokenStream::line(const uint32_t index) const {
+    const uint32_t offset = spans.at(index).offset;
+
+    // Only reachable after an unterminated comment swallowed the final `\n`
+    if (offset >= source.content.size()) {
+        return source.lineCount();
+    }
+
+    const std::vector<uint32_t>& line_offsets = source.line_offsets;
+    return std::upper_bound(line_offsets.begin(), line_offsets.end(), offset) - line_offsets.begin() - 1;
+}
+
+uint32_t TokenStream::column(const uint32_t index) const {
+    const uint32_t line_number = line(index);
+
+    if (line_number >= source.lineCount()) {
+        return 0;
+    }
+
+    return spans[index].offset - source.line_offsets[line_number];
+}
+
+Token TokenStream::at(const uint32_t index) const {
+    Token token = {};
+
+    token.index = index;
+    token.line = line(index);
+    token.column = column(index);
+    token.type = type(index);
+    token.lexeme = lexeme(index);
+    token.symbol = symbol(index);
+
+    return token;
+}
@@ -3,10 +3,19 @@
 /// *==============================================================*
 #include "include/tokenizer.hpp"
 #include "include/cclass.hpp"
+#include "include/scan.hpp"
+
+#include <cstring>
+#include <thread>
 
 using namespace XC;
 
-static const std::unordered_map<std::string, TokenType> reserved_words = {
+struct ReservedWord {
+    std::string_view spelling;
+    TokenType type;
+};
+
+static constexpr ReservedWord reserved_words[] = {
     {   "bool",        TokenType::TYPE_BOOL                },
     {   "break",       TokenType::KEYWORD_BREAK            },
     {   "byte",        TokenType::TYPE_BYTE                },
@@ -28,299 +37,381 @@ static const std::unordered_map<std::string, TokenType> reserved_words = {
     {   "while",       TokenType::KEYWORD_WHILE            }
 };
 
-Tokenizer::Tokenizer(const std::unique_ptr<Module>& module)
-    : module(module),
-      head({0, 0}),
-      tail({0, 0}),
-      lexeme_buffer(),
-      tokens(std::make_unique<TokenStream>()),
-      has_error(false) {
-    tokenize();
-}
+/// A perfect hash over the reserved words, found at compile time. The
+/// first, second and last characters plus the length of a word are mixed
+/// by a multiplier, searched for until no two reserved words share a slot.
+struct ReservedWordTable {
+    static constexpr uint32_t MAX_BITS = 10;
+
+    ReservedWord slots[1 << MAX_BITS];
+    uint32_t multiplier;
+    uint32_t bits;
+    size_t shortest;
+    size_t longest;
+
+    constexpr uint32_t slotOf(const std::string_view word) const {
+        const uint32_t key = (uint8_t) word[0]
+            | ((uint8_t) word[min_of(word.size(), 2) - 1] << 8)
+            | ((uint8_t) word[word.size() - 1] << 16)
+            | ((uint32_t) word.size() << 24);
+
+        return (key * multiplier) >> (32 - bits);
+    }
+};
 
-void Tokenizer::tokenize(void) {
-    while (!atEnd()) {
-        process(next());
+static constexpr ReservedWordTable buildReservedWordTable(void) {
+    ReservedWordTable table = {};
+
+    table.shortest = reserved_words[0].spelling.size();
+    table.longest = reserved_words[0].spelling.size();
+
+    for (const ReservedWord& word : reserved_words) {
+        table.shortest = min_of(table.shortest, word.spelling.size());
+        table.longest = max_of(table.longest, word.spelling.size());
     }
 
-    addToken(TokenType::END_OF_FILE);
-}
+    // Start at twice as many slots as there are words and grow as needed
+    table.bits = 1;
+    while ((1u << table.bits) < 2 * std::size(reserved_words)) {
+        ++table.bits;
+    }
 
-void Tokenizer::process(const char c) {
-    switch (c) {
-        case '(':
-            // --> ('(') --> Left parenthesis ('(')
-            addToken(TokenType::PUNCTUATION_LEFT_PARENTHESIS);
-            break;
-        case ')':
-            // --> (')') --> Right parenthesis (')')
-            addToken(TokenType::PUNCTUATION_RIGHT_PARENTHESIS);
-            break;
-        case '[':
-            // --> ('[') --> Left bracket ('[')
-            addToken(TokenType::PUNCTUATION_LEFT_BRACKET);
-            break;
-        case ']':
-            // --> (']') --> Right bracket (']')
-            addToken(TokenType::PUNCTUATION_RIGHT_BRACKET);
-            break;
-        case '{':
-            // --> ('{') --> Left brace ('{')
-            addToken(TokenType::PUNCTUATION_LEFT_BRACE);
-            break;
-        case '}':
-            // --> ('}') --> Right brace ('}')
-            addToken(TokenType::PUNCTUATION_RIGHT_BRACE);
-            break;
-        case ';':
-            // --> (';') --> Semi colon (';')
-            addToken(TokenType::PUNCTUATION_SEMI_COLON);
-            break;
-        case ':':
-            // --> (':')
-            //       |
-            //       +--- (':') --> Double colon ('::')
-            //       |
-            //       +--> Colon (':')
-            addToken(match(':') ? TokenType::PUNCTUATION_DOUBLE_COLON : TokenType::PUNCTUATION_COLON);
-            break;
-        case ',':
-            // --> (',') --> Comma (',')
-            addToken(TokenType::PUNCTUATION_COMMA);
-            break;
-        case '.':
-            // --> ('.') --> Dot ('.')
-            addToken(TokenType::PUNCTUATION_DOT);
-            break;
-        case '~':
-            // --> ('~') --> Bitwise complement ('~')
-            addToken(TokenType::BITWISE_OP_COMPLEMENT);
-            break;
-        case '=':
-            // --> ('=')
-            //       |
-            //       +--- ('=') --> Relational equality ('==')
-            //       |
-            //       +--> Assignment ('=')
-            addToken(match('=') ? TokenType::RELATIONAL_OP_EQUALITY : TokenType::ASSIGNMENT_ASSIGN);
-            break;
-        case '+':
-            // --> ('+')
-            //       |
-            //       +--- ('+') --> Increment ('++')
-            //       |
-            //       +--- ('=') --> Assignment addition ('+=')
-            //       |
-            //       +--> Arithmetic addition ('+')
-            addToken(match('+') ? TokenType::OP_INCREMENT : (match('=') ? TokenType::ASSIGNMENT_OP_ADD : TokenType::ARITHMETIC_OP_ADD));
-            break;
-        case '-':
-            // --> ('-')
-            //       |
-            //       +--- ('-') --> Decrement ('--')
-            //       |
-            //       +--- ('=') --> Assignment subtraction ('-=')
-            //       |
-            //       +--> Arithmetic subtraction ('-')
-            addToken(match('-') ? TokenType::OP_DECREMENT : (match('=') ? TokenType::ASSIGNMENT_OP_SUB : TokenType::ARITHMETIC_OP_SUB));
-            break;
-        case '*':
-            // --> ('*')
-            //       |
-            //       +--- ('=') --> Assignment multiplication ('*=')
-            //       |
-            //       +--> Arithmetic multiplication ('*')
-            addToken(match('=') ? TokenType::ASSIGNMENT_OP_MUL : TokenType::ARITHMETIC_OP_MUL);
-            break;
-        case '/':
-            // --> ('/')
-            //       |
-            //       +--- ('/') --> Single-line comment
-            //       |
-            //       +--- ('*') --> Multi-line comment
-            //       |
-            //       +--- ('=') --> Assignment division ('/=')
-            //       |
-            //       +--> Arithmetic division ('/')
-            addToken(match('/') ? extractSingleLineComment() : (match('*') ? extractMultiLineComment() : (match('=') ? TokenType::ASSIGNMENT_OP_DIV : TokenType::ARITHMETIC_OP_DIV)));
-            break;
-        case '%':
-            // --> ('%')
-            //       |
-            //       +--- ('=') --> Assignment modulus ('%=')
-            //       |
-            //       +--> Arithmetic modulus ('%')
-            addToken(match('=') ? TokenType::ASSIGNMENT_OP_MOD : TokenType::ARITHMETIC_OP_MOD);
-            break;
-        case '&':
-            // --> ('&')
-            //       |
-            //       +--- ('&') --> Boolean AND ('&&')
-            //       |
-            //       +--- ('=') --> Assignment AND ('&=')
-            //       |
-            //       +--> Bitwise AND ('&')
-            addToken(match('&') ? TokenType::BOOLEAN_OP_AND : (match('=') ? TokenType::ASSIGNMENT_OP_AND : TokenType::BITWISE_OP_AND));
-            break;
-        case '^':
-            // --> ('^')
-            //       |
-            //       +--- ('^') --> Boolean XOR ('^^')
-            //       |
-            //       +--- ('=') --> Assignment XOR ('^=')
-            //       |
-            //       +--> Bitwise XOR ('^')
-            addToken(match('^') ? TokenType::BOOLEAN_OP_XOR : (match('=') ? TokenType::ASSIGNMENT_OP_XOR : TokenType::BITWISE_OP_XOR));
-            break;
-        case '|':
-            // --> ('|')
-            //       |
-            //       +--- ('|') --> Boolean OR ('||')
-            //       |
-            //       +--- ('=') --> Assignment OR ('|=')
-            //       |
-            //       +--> Bitwise OR ('|')
-            addToken(match('|') ? TokenType::BOOLEAN_OP_OR : (match('=') ? TokenType::ASSIGNMENT_OP_OR : TokenType::BITWISE_OP_OR));
-            break;
-        case '<':
-            // --> ('<')
-            //       |
-            //       +--- ('<') --> Bitwise left shift ('<<')
-            //       |
-            //       +--- ('=') --> Relational less than or equal to ('<=')
-            //       |
-            //       +--> Relational less than ('<')
-            addToken(match('<') ? TokenType::BITWISE_OP_LEFT_SHIFT : (match('=') ? TokenType::RELATIONAL_OP_LESS_THAN_EQUAL : TokenType::RELATIONAL_OP_LESS_THAN));
-            break;
-        case '>':
-            // --> ('>')
-            //       |
-            //       +--- ('>') --> Bitwise right shift ('>>')
-            //       |
-            //       +--- ('=') --> Relational greater than or equal to ('>=')
-            //       |
-            //       +--> Relational greater than ('>')
-            addToken(match('>') ? TokenType::BITWISE_OP_RIGHT_SHIFT : (match('=') ? TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL : TokenType::RELATIONAL_OP_GREATER_THAN));
-            break;
-        case '!':
-            // --> ('!')
-            //       |
-            //       +--- ('=') --> Relational inequality ('!=')
-            //       |
-            //       +--> Boolean NOT ('!')
-            addToken(match('=') ? TokenType::RELATIONAL_OP_INEQUALITY : TokenType::BOOLEAN_OP_NOT);
-            break;
-        // case '\'':
-        //     addToken(extractCharacterLiteral());
-        //     break;
-        default:
-            if (isWhitespace(c)) {
-                addToken(extractWhitespace());
-            } else if (c == '0' && current() != '.') {
-                addToken(extractZeroPrefixNumericLiteral());
-            } else if (isDigit(c)) {
-                addToken(extractNumericLiteral());
-            } else if (c == '_' || isLetter(c)) {
-                addToken(extractIdentifier());
-            } else {
-                addToken(extractUnrecognizedSymbol());
+    for (; table.bits <= ReservedWordTable::MAX_BITS; ++table.bits) {
+        for (uint32_t candidate = 1; candidate < 4096; ++candidate) {
+            // Odd multipliers spread over the high bits of the product
+            table.multiplier = candidate * 0x9E3779B1u | 1;
+
+            bool taken[1 << ReservedWordTable::MAX_BITS] = {};
+            bool perfect = true;
+
+            for (const ReservedWord& word : reserved_words) {
+                const uint32_t slot = table.slotOf(word.spelling);
+
+                if (taken[slot]) {
+                    perfect = false;
+                    break;
+                }
+
+                taken[slot] = true;
             }
-            break;
+
+            if (perfect) {
+                for (const ReservedWord& word : reserved_words) {
+                    table.slots[table.slotOf(word.spelling)] = word;
+                }
+
+                return table;
+            }
+        }
     }
-}
 
-const std::string& Tokenizer::contentOnLine(const uint32_t line) {
-    return module->source->content.at(line);
+    table.bits = 0;
+    return table;
 }
 
-bool Tokenizer::atEnd(void) {
-    const uint32_t total_lines = module->source->content.size();
-    
-    const bool past_last_line = head.line > total_lines - 1;
-    const bool on_last_line = head.line == total_lines - 1;
-    const bool on_end_of_line = head.column >= contentOnLine(head.line).size() - 1;
-    const bool on_end_of_content = on_last_line && on_end_of_line;
+static constexpr ReservedWordTable reserved_word_table = buildReservedWordTable();
+
+static_assert(reserved_word_table.bits != 0, "no perfect hash found for the reserved words");
+
+/// @return the type of the reserved word, or `TokenType::IDENTIFIER`
+static inline TokenType classifyWord(const std::string_view word) {
+    if (word.size() < reserved_word_table.shortest || word.size() > reserved_word_table.longest) {
+        return TokenType::IDENTIFIER;
+    }
+
+    const ReservedWord& candidate = reserved_word_table.slots[reserved_word_table.slotOf(word)];
 
-    return past_last_line || on_end_of_content;
+    return (candidate.spelling == word) ? candidate.type : TokenType::IDENTIFIER;
 }
 
-char Tokenizer::current(void) {
-    return contentOnLine(head.line).at(head.column);
+// <*> ================================================================ <*>
+
+struct OperatorSpelling {
+    const char* spelling;
+    TokenType type;
+};
+
+// `/` is listed for `/` and `/=`, the comment openers are handled before
+// the automaton is entered.
+static constexpr OperatorSpelling operators[] = {
+    {   "(",    TokenType::PUNCTUATION_LEFT_PARENTHESIS         },
+    {   ")",    TokenType::PUNCTUATION_RIGHT_PARENTHESIS        },
+    {   "[",    TokenType::PUNCTUATION_LEFT_BRACKET             },
+    {   "]",    TokenType::PUNCTUATION_RIGHT_BRACKET            },
+    {   "{",    TokenType::PUNCTUATION_LEFT_BRACE               },
+    {   "}",    TokenType::PUNCTUATION_RIGHT_BRACE              },
+    {   ";",    TokenType::PUNCTUATION_SEMI_COLON               },
+    {   ":",    TokenType::PUNCTUATION_COLON                    },
+    {   "::",   TokenType::PUNCTUATION_DOUBLE_COLON             },
+    {   ",",    TokenType::PUNCTUATION_COMMA                    },
+    {   ".",    TokenType::PUNCTUATION_DOT                      },
+    {   "~",    TokenType::BITWISE_OP_COMPLEMENT                },
+    {   "=",    TokenType::ASSIGNMENT_ASSIGN                    },
+    {   "==",   TokenType::RELATIONAL_OP_EQUALITY               },
+    {   "+",    TokenType::ARITHMETIC_OP_ADD                    },
+    {   "++",   TokenType::OP_INCREMENT                         },
+    {   "+=",   TokenType::ASSIGNMENT_OP_ADD                    },
+    {   "-",    TokenType::ARITHMETIC_OP_SUB                    },
+    {   "--",   TokenType::OP_DECREMENT                         },
+    {   "-=",   TokenType::ASSIGNMENT_OP_SUB                    },
+    {   "*",    TokenType::ARITHMETIC_OP_MUL                    },
+    {   "*=",   TokenType::ASSIGNMENT_OP_MUL                    },
+    {   "/",    TokenType::ARITHMETIC_OP_DIV                    },
+    {   "/=",   TokenType::ASSIGNMENT_OP_DIV                    },
+    {   "%",    TokenType::ARITHMETIC_OP_MOD                    },
+    {   "%=",   TokenType::ASSIGNMENT_OP_MOD                    },
+    {   "&",    TokenType::BITWISE_OP_AND                       },
+    {   "&&",   TokenType::BOOLEAN_OP_AND                       },
+    {   "&=",   TokenType::ASSIGNMENT_OP_AND                    },
+    {   "^",    TokenType::BITWISE_OP_XOR                       },
+    {   "^^",   TokenType::BOOLEAN_OP_XOR                       },
+    {   "^=",   TokenType::ASSIGNMENT_OP_XOR                    },
+    {   "|",    TokenType::BITWISE_OP_OR                        },
+    {   "||",   TokenType::BOOLEAN_OP_OR                        },
+    {   "|=",   TokenType::ASSIGNMENT_OP_OR                     },
+    {   "<",    TokenType::RELATIONAL_OP_LESS_THAN              },
+    {   "<<",   TokenType::BITWISE_OP_LEFT_SHIFT                },
+    {   "<=",   TokenType::RELATIONAL_OP_LESS_THAN_EQUAL        },
+    {   ">",    TokenType::RELATIONAL_OP_GREATER_THAN           },
+    {   ">>",   TokenType::BITWISE_OP_RIGHT_SHIFT               },
+    {   ">=",   TokenType::RELATIONAL_OP_GREATER_THAN_EQUAL     },
+    {   "!",    TokenType::BOOLEAN_OP_NOT                       },
+    {   "!=",   TokenType::RELATIONAL_OP_INEQUALITY             }
+};
+
+/// A DFA over the spellings above. State 0 is the start state and doubles
+/// as "no transition", since no spelling ever leads back to it.
+struct OperatorAutomaton {
+    static constexpr uint32_t MAX_STATES = 64;
+
+    uint8_t transitions[MAX_STATES][256];
+    TokenType accepts[MAX_STATES];
+    uint32_t states;
+};
+
+static constexpr OperatorAutomaton buildOperatorAutomaton(void) {
+    OperatorAutomaton automaton = {};
+    automaton.states = 1;
+
+    for (uint32_t i = 0; i < OperatorAutomaton::MAX_STATES; ++i) {
+        automaton.accepts[i] = TokenType::UNKNOWN;
+    }
+
+    for (const OperatorSpelling& op : operators) {
+        uint8_t state = 0;
+
+        for (const char* c = op.spelling; *c != '\0'; ++c) {
+            uint8_t& next = automaton.transitions[state][(uint8_t) *c];
+
+            if (next == 0) {
+                next = automaton.states++;
+            }
+
+            state = next;
+        }
+
+        automaton.accepts[state] = op.type;
+    }
+
+    return automaton;
 }
 
-char Tokenizer::next(void) {
-    const char c = current();
+static constexpr OperatorAutomaton operator_automaton = buildOperatorAutomaton();
 
-    if (c == '\n') {
-        head.line += 1;
-        head.column = 0;
-    } else {
-        head.column += 1;
+static constexpr bool everyOperatorStateAccepts(void) {
+    for (uint32_t state = 1; state < operator_automaton.states; ++state) {
+        if (operator_automaton.accepts[state] == TokenType::UNKNOWN) {
+            return false;
+        }
     }
 
-    lexeme_buffer.push_back(c);
-    return c;
+    return operator_automaton.states <= OperatorAutomaton::MAX_STATES;
 }
 
-char Tokenizer::peek(void) {
-    if (atEnd()) {
-        return '\0';
+// Longest match is taken without backtracking, which is only correct while
+// every prefix of an operator is an operator itself.
+static_assert(everyOperatorStateAccepts(), "every prefix of an operator must be an operator");
+
+/// What the first character of a lexeme starts.
+enum class LexemeStart : uint8_t {
+    UNRECOGNIZED,
+    WHITESPACE,
+    IDENTIFIER,
+    ZERO,
+    DIGIT,
+    SLASH,
+    OPERATOR
+};
+
+static constexpr std::array<LexemeStart, 256> buildLexemeStarts(void) {
+    std::array<LexemeStart, 256> starts = {};
+
+    for (uint32_t c = 0; c < 256; ++c) {
+        if (c == '/') {
+            starts[c] = LexemeStart::SLASH;
+        } else if (operator_automaton.transitions[0][c] != 0) {
+            starts[c] = LexemeStart::OPERATOR;
+        } else if (isWhitespace(c)) {
+            starts[c] = LexemeStart::WHITESPACE;
+        } else if (c == '0') {
+            starts[c] = LexemeStart::ZERO;
+        } else if (isDigit(c)) {
+            starts[c] = LexemeStart::DIGIT;
+        } else if (c == '_' || isLetter(c)) {
+            starts[c] = LexemeStart::IDENTIFIER;
+        } else {
+            starts[c] = LexemeStart::UNRECOGNIZED;
+        }
     }
 
-    if (current() == '\n') {
-        return contentOnLine(head.line).at(0);
+    return starts;
+}
+
+static constexpr std::array<LexemeStart, 256> lexeme_starts = buildLexemeStarts();
+
+// <*> ================================================================ <*>
+
+Tokenizer::Tokenizer(const std::unique_ptr<Module>& module)
+    : Tokenizer(module, module->names, 0, module->source->content.size()) {}
+
+Tokenizer::Tokenizer(const std::unique_ptr<Module>& module, Interner& names, const uint32_t from, const uint32_t to)
+    : module(module),
+      names(names),
+      begin(module->source->content.data()),
+      limit(begin + max_of(module->source->content.size(), 1) - 1),
+      stop(min_of(begin + to, limit)),
+      cursor(begin + from),
+      lexeme_start(cursor),
+      current_line(0),
+      emitted(0),
+      tokens(nullptr),
+      has_error(false),
+      defer_reports(false),
+      reports() {}
+
+Token Tokenizer::nextToken(void) {
+    const TokenType type = scanSignificant();
+    const Token token = createToken(type);
+
+    if (type != TokenType::END_OF_FILE) {
+        ++emitted;
     }
 
-    return contentOnLine(head.line).at(head.column + 1);
+    return token;
 }
 
-bool Tokenizer::match(const char expect) {
-    if (atEnd() || current() != expect) {
-        return false;
+bool Tokenizer::hasError(void) const {
+    return has_error;
+}
+
+void Tokenizer::tokenize(void) {
+    tokens = std::make_unique<TokenStream>(*module->source);
+
+    // Typical sources average a little over 3 bytes per token; reserving
+    // up front avoids copying the whole stream while it grows.
+    tokens->reserve((stop - cursor) / 3);
+
+    // END_OF_FILE is appended by the caller, a chunk does not end the file
+    for (TokenType type; (type = scanSignificant()) != TokenType::END_OF_FILE;) {
+        tokens->append(type, lexeme_start - begin, cursor - lexeme_start, symbolOf(type));
     }
+}
 
-    next();
+TokenType Tokenizer::scanSignificant(void) {
+    while (cursor < stop) {
+        switch (const TokenType type = scan()) {
+            case TokenType::WHITESPACE:
+            case TokenType::COMMENT:
+            case TokenType::UNKNOWN:
+                break;
+            default:
+                return type;
+        }
+    }
 
-    return true;
+    // Keeps returning the same END_OF_FILE once the source is exhausted
+    lexeme_start = cursor;
+    return TokenType::END_OF_FILE;
 }
 
-std::string Tokenizer::consume(void) {
-    std::string lexeme = lexeme_buffer;
+TokenType Tokenizer::scan(void) {
+    lexeme_start = cursor;
+
+    const char c = *cursor++;
+
+    switch (lexeme_starts[(uint8_t) c]) {
+        case LexemeStart::OPERATOR:
+            return extractOperator();
+        case LexemeStart::SLASH:
+            if (*cursor == '/' && cursor < limit) {
+                ++cursor;
+                return extractSingleLineComment();
+            }
+
+            if (*cursor == '*' && cursor < limit) {
+                ++cursor;
+                return extractMultiLineComment();
+            }
+
+            return extractOperator();
+        case LexemeStart::WHITESPACE:
+            return extractWhitespace();
+        case LexemeStart::ZERO:
+            return (*cursor != '.') ? extractZeroPrefixNumericLiteral() : extractNumericLiteral();
+        case LexemeStart::DIGIT:
+            return extractNumericLiteral();
+        case LexemeStart::IDENTIFIER:
+            return extractIdentifier();
+        default:
+            return extractUnrecognizedSymbol();
+    }
+}
 
-    lexeme_buffer.clear();
+std::string_view Tokenizer::contentOnLine(const uint32_t line) {
+    return module->source->lineAt(line);
+}
 
-    tail = head;
+std::string_view Tokenizer::lexeme(void) {
+    return std::string_view(lexeme_start, cursor - lexeme_start);
+}
 
-    return lexeme;
+SymbolId Tokenizer::symbolOf(const TokenType type) {
+    return isNamed(type) ? names.intern(lexeme()) : NO_SYMBOL;
 }
 
-void Tokenizer::addToken(const TokenType type) {
-    switch (type) {
-        case TokenType::WHITESPACE:
-        case TokenType::COMMENT:
-        case TokenType::UNKNOWN:
-            consume();
-            return;
-        default:; 
+Tokenizer::Position Tokenizer::locate(const uint32_t offset) {
+    const std::vector<uint32_t>& line_offsets = module->source->line_offsets;
+
+    // Only reachable after an unterminated comment swallowed the final `\n`
+    if (offset >= module->source->content.size()) {
+        return {(uint32_t) line_offsets.size(), 0};
     }
 
-    tokens->push_back(createToken(type));
+    // Offsets are located in increasing order, so the line only moves forward
+    if (line_offsets[current_line] > offset) {
+        current_line = 0;
+    }
 
-    // Token& tk = tokens->back();
-    // std::cout << "[" << tk.index + 1 << "] "
-    //     << tk.line + 1 << ":" << tk.column + 1 << ", "
-    //     << "type[" << int(tk.type) << "], " 
-    //     << "lexeme`" << tk.lexeme << "`" << std::endl;
+    while (current_line + 1 < line_offsets.size() && line_offsets[current_line + 1] <= offset) {
+        ++current_line;
+    }
+
+    return {current_line, offset - line_offsets[current_line]};
 }
 
 Token Tokenizer::createToken(const TokenType type) {
+    const Position position = locate(lexeme_start - begin);
+
     Token token = {};
 
-    token.line = tail.line;
-    token.column = tail.column;
-    token.index = tokens->size();
-    token.lexeme = consume();
+    token.line = position.line;
+    token.column = position.column;
+    token.index = emitted;
+    token.lexeme = lexeme();
     token.type = type;
+    token.symbol = symbolOf(type);
+
+    lexeme_start = cursor;
 
     return token;
 }
@@ -343,14 +434,18 @@ TokenType Tokenizer::error(const std::string message) {
         const std::string line_number = std::to_string(error.line + 1);
         const std::string divider = std::string(line_number.size() + 2, ' ') + ':';
 
-        const std::string line_content = " " + line_number + " | " + contentOnLine(error.line);
+        const std::string line_content = " " + line_number + " | " + std::string(contentOnLine(error.line));
         const std::string underline = std::string(min_of(error.lexeme.size(), contentOnLine(error.line).size() - error.column), '^');
         const std::string footer = divider + std::string(error.column + 1, ' ') + underline;
 
         preview = divider + '\n' + line_content + footer;
     }
 
-    std::cerr << header << info << preview << std::endl;
+    if (defer_reports) {
+        reports.push_back({(uint32_t) (error.lexeme.data() - begin), header + info + preview});
+    } else {
+        std::cerr << header << info << preview << std::endl;
+    }
 
     has_error = true;
     return TokenType::UNKNOWN;
@@ -360,287 +455,320 @@ TokenType Tokenizer::error(const std::string message, const char symbol) {
     return error(message + ": `" + std::string(1, symbol) + "`");
 }
 
-TokenType Tokenizer::extractSingleLineComment(void) {
-    while (!atEnd() && !match('\n')) {
-        next();
+TokenType Tokenizer::extractOperator(void) {
+    const char* c = cursor;
+
+    uint8_t state = operator_automaton.transitions[0][(uint8_t) c[-1]];
+
+    // The sentinel `\n` has no transition, so this never runs past `limit`
+    while (const uint8_t next = operator_automaton.transitions[state][(uint8_t) *c]) {
+        state = next;
+        ++c;
     }
 
+    cursor = c;
+
+    return operator_automaton.accepts[state];
+}
+
+TokenType Tokenizer::extractSingleLineComment(void) {
+    const char* newline = (const char*) std::memchr(cursor, '\n', limit - cursor);
+
+    cursor = (newline != nullptr) ? newline + 1 : limit;
+
     return TokenType::COMMENT;
 }
 
 TokenType Tokenizer::extractMultiLineComment(void) {
-    while (!atEnd() && !(match('*') && match('/'))) {
-        next();
+    const char* c = cursor;
+
+    // A `*` that is not followed by `/` also swallows the character after
+    // it, so `**/` does not close the comment. This may step past `limit`.
+    while (c < limit) {
+        const char* star = (const char*) std::memchr(c, '*', limit - c);
+
+        if (star == nullptr) {
+            c = limit;
+            break;
+        }
+
+        c = star + 1;
+
+        if (c < limit && *c == '/') {
+            ++c;
+            break;
+        }
+
+        ++c;
     }
 
+    cursor = c;
+
     return TokenType::COMMENT;
 }
 
 TokenType Tokenizer::extractIdentifier(void) {
-    while (!atEnd() && (current() == '_' || isLetterOrDigit(current()))) {
-        next();
-    }
+    // Most identifiers are short, only longer runs are worth a vector scan
+    const char* c = cursor;
+    const char* const short_run = (limit - c > 8) ? c + 8 : limit;
 
-    if (reserved_words.count(lexeme_buffer) > 0) {
-        return reserved_words.at(lexeme_buffer);
+    while (c < short_run && isIdentifierCharacter(*c)) {
+        ++c;
     }
 
-    return TokenType::IDENTIFIER;
+    cursor = (c == short_run) ? Scan::scanners.skip_identifier(c, limit) : c;
+
+    return classifyWord(lexeme());
 }
 
 TokenType Tokenizer::extractWhitespace(void) {
-    while (!atEnd() && isWhitespace(current())) {
-        next();
+    // A single space is by far the most common run
+    if (cursor < limit && isWhitespace(*cursor)) {
+        cursor = Scan::scanners.skip_whitespace(cursor + 1, limit);
     }
-    
+
     return TokenType::WHITESPACE;
 }
 
 TokenType Tokenizer::extractZeroPrefixNumericLiteral(void) {
-    if (match('b')) {
-        return extractBinaryLiteral();
-    } else if (match('o')) {
-        return extractOctalLiteral();
-    } else if (match('x')) {
-        return extractHexadecimalLiteral();
-    } else if (isLetterOrDigit(current()) || current() == '_') {
-        while (!atEnd() && !(isSymbol(current()) || isWhitespace(current()))) {
-            next();
+    if (cursor < limit) {
+        switch (*cursor) {
+            case 'b':
+                ++cursor;
+                return extractBinaryLiteral();
+            case 'o':
+                ++cursor;
+                return extractOctalLiteral();
+            case 'x':
+                ++cursor;
+                return extractHexadecimalLiteral();
+            default:
+                break;
         }
+    }
+
+    if (isIdentifierCharacter(*cursor)) {
+        skipInvalidLiteral();
 
         return error("`0` should be alone or pair with `b`, `o`, or `x`");
     }
+
     return TokenType::INTEGER_LITERAL;
 }
 
 TokenType Tokenizer::extractBinaryLiteral(void) {
-    if (!isBinaryDigit(current())) {
-        return error("incomplete or invalid binary literal");
+    return extractDigits(CharacterClass::BINARY_DIGIT, "binary");
+}
+
+TokenType Tokenizer::extractOctalLiteral(void) {
+    return extractDigits(CharacterClass::OCTAL_DIGIT, "octal");
+}
+
+TokenType Tokenizer::extractHexadecimalLiteral(void) {
+    return extractDigits(CharacterClass::HEXADECIMAL_DIGIT, "hexadecimal");
+}
+
+TokenType Tokenizer::extractDigits(const uint8_t digits, const std::string& base) {
+    if (!CharacterClass::is(*cursor, digits)) {
+        return error("incomplete or invalid " + base + " literal");
     }
 
-    while (!atEnd() && isBinaryDigit(current())) {
-        next();
+    while (CharacterClass::is(*cursor, digits)) {
+        ++cursor;
     }
 
-    if (isLetterOrDigit(current()) || current() == '_') {
-        const char invalid = current();
-        while (!atEnd() && !(isSymbol(current()) || isWhitespace(current()))) {
-            next();
-        }
+    if (isIdentifierCharacter(*cursor)) {
+        const char invalid = *cursor;
+
+        skipInvalidLiteral();
 
-        return error("invalid binary digit", invalid);
+        return error("invalid " + base + " digit", invalid);
     }
 
     return TokenType::INTEGER_LITERAL;
 }
 
-TokenType Tokenizer::extractOctalLiteral(void) {
-    if (!isOctalDigit(current())) {
-        return error("incomplete or invalid octal literal");
-    }
+TokenType Tokenizer::extractNumericLiteral(void) {
+    const char* c = cursor;
 
-    while (!atEnd() && isOctalDigit(current())) {
-        next();
+    while (isDigit(*c)) {
+        ++c;
     }
 
-    if (isLetterOrDigit(current()) || current() == '_') {
-        const char invalid = current();
-        while (!atEnd() && !(isSymbol(current()) || isWhitespace(current()))) {
-            next();
+    if (c < limit && *c == '.' && isDigit(c[1])) {
+        ++c;
+
+        while (isDigit(*c)) {
+            ++c;
         }
 
-        return error("invalid octal digit", invalid);
+        cursor = c;
+
+        return TokenType::FLOAT_LITERAL;
     }
 
+    cursor = c;
+
     return TokenType::INTEGER_LITERAL;
 }
 
-TokenType Tokenizer::extractHexadecimalLiteral(void) {
-    if (!isHexadecimalDigit(current())) {
-        return error("incomplete or invalid hexadecimal literal");
+TokenType Tokenizer::extractUnrecognizedSymbol(void) {
+    while (cursor < limit && !isRecognized(*cursor)) {
+        ++cursor;
     }
 
-    while (!atEnd() && isHexadecimalDigit(current())) {
-        next();
+    return error("Unrecognized symbol", *lexeme_start);
+}
+
+void Tokenizer::skipInvalidLiteral(void) {
+    while (cursor < limit && !(isSymbol(*cursor) || isWhitespace(*cursor))) {
+        ++cursor;
     }
+}
 
-    if (isLetterOrDigit(current()) || current() == '_') {
-        const char invalid = current();
-        while (!atEnd() && !(isSymbol(current()) || isWhitespace(current()))) {
-            next();
-        }
+// Below this splitting a file costs more than lexing the pieces in parallel saves
+static constexpr uint32_t MIN_CHUNK_SIZE = 1 << 20;
+
+struct Tokenizer::Chunk {
+    uint32_t from;
+    uint32_t to;
 
-        return error("invalid hexadecimal digit", invalid);
+    Interner names; // merged into the module's once the chunk is stitched
+    std::unique_ptr<Tokenizer> tokenizer;
+};
+
+std::unique_ptr<TokenStream> Tokenizer::extractTokenStream(const std::unique_ptr<Module>& module) {
+    const uint32_t chunks_fitting = max_of(module->source->content.size() / MIN_CHUNK_SIZE, 1);
+    const uint32_t chunk_count = min_of(module->options.jobs, chunks_fitting);
+
+    if (chunk_count > 1) {
+        return tokenizeInParallel(module, chunk_count);
     }
 
-    return TokenType::INTEGER_LITERAL;
+    Tokenizer tokenizer(module);
+    tokenizer.tokenize();
+    tokenizer.tokens->append(TokenType::END_OF_FILE, tokenizer.cursor - tokenizer.begin, 0, NO_SYMBOL);
+
+    return tokenizer.has_error ? none() : some(std::move(tokenizer.tokens));
 }
 
-TokenType Tokenizer::extractNumericLiteral(void) {
-    while (isDigit(current())) {
-        next();
+std::unique_ptr<TokenStream> Tokenizer::tokenizeInParallel(const std::unique_ptr<Module>& module, const uint32_t chunk_count) {
+    const std::string_view content = module->source->content;
+
+    // Chunks start right after a `\n`, so only a multi-line comment can run
+    // from one chunk into the next
+    std::deque<Chunk> chunks;
+    for (uint32_t i = 0, from = 0; i < chunk_count && from < content.size(); ++i) {
+        const uint32_t even_split = (uint64_t) content.size() * (i + 1) / chunk_count;
+        const size_t newline = content.find('\n', max_of(even_split, from));
+
+        Chunk& chunk = chunks.emplace_back();
+        chunk.from = from;
+        chunk.to = (i + 1 == chunk_count || newline == std::string_view::npos) ? content.size() : newline + 1;
+
+        from = chunk.to;
     }
 
-    if (isDigit(peek()) && match('.')) {
-        while (isDigit(current())) {
-            next();
+    // Every chunk is lexed as if it started on a token boundary
+    {
+        std::vector<std::thread> workers;
+
+        for (Chunk& chunk : chunks) {
+            workers.emplace_back([&module, &chunk] {
+                chunk.tokenizer.reset(new Tokenizer(module, chunk.names, chunk.from, chunk.to));
+                chunk.tokenizer->defer_reports = true;
+                chunk.tokenizer->tokenize();
+            });
         }
 
-        return TokenType::FLOAT_LITERAL;
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
     }
 
-    return TokenType::INTEGER_LITERAL;
-}
+    struct Piece {
+        const TokenStream* tokens;
+        uint32_t first; // tokens before it were lexed from a wrong start
+        uint32_t at;
+        std::vector<SymbolId> remap;
+    };
+
+    std::vector<Piece> pieces;
+    std::vector<std::unique_ptr<Tokenizer>> relexed;
+    uint32_t resumed = 0; // where the previous chunk really stopped
+    uint32_t size = 0;
+    bool has_error = false;
+
+    // Only a chunk starting where the previous one stopped was lexed correctly
+    // from its start. Otherwise its tokens are kept from the first one at that
+    // point on, since lexing from there gives the same tokens, and if there is
+    // no such token the chunk is lexed again. Names are merged in order so
+    // symbol ids come out the same as with a single tokenizer.
+    for (Chunk& chunk : chunks) {
+        if (resumed >= chunk.to) {
+            continue; // swallowed by a comment from an earlier chunk
+        }
 
-// TokenType Tokenizer::extractCharacterLiteral(void) {
-//     if (match('\\')) {
-//         return extractEscapeSequence();
-//     }
-
-//     const char literal = next();
-//     if (literal == '\'') {
-//         return error("character literal cannot be empty");
-//     }
-
-//     if (isWhitespace(literal) && literal != ' ') {
-//         while (!atEnd() && !match('\'')) {
-//             next();
-//         }
-
-//         return error("whitespace other than ` ` is not allow in a character literal; use an escape sequence instead");
-//     }
-
-//     if (!match('\'')) {
-//         while (!atEnd() && !match('\'')) {
-//             next();
-//         }
-
-//         return error(atEnd() ? "missing terminating `\'`" : "too many characters for a character literal");
-//     }
-
-//     return TokenType::CHARACTER_LITERAL;
-// }
-
-// TokenType Tokenizer::extractEscapeSequence(void) {
-//     const char c = next();
-//     switch (c) {
-//         case 'n':
-//         case 't':
-//         case 'b':
-//         case 'r':
-//         case 'a':
-//         case '\'':
-//         case '\"':
-//         case '\\':
-//         case 'f':
-//         case 'v':
-//             break;
-//         default:
-//             // TODO: refactor this 
-//             if (c == '0') {
-//                 if (match('b')) {
-//                     if (!isBinaryDigit(current())) {
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("incomplete or invalid binary literal");
-//                     }
-
-//                     while (!atEnd() && isBinaryDigit(current())) {
-//                         next();
-//                     }
-
-//                     if (isLetterOrDigit(current()) || current() == '_') {
-//                         const char invalid = current();
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("invalid binary digit", invalid); 
-//                     }
-//                 } else if (match('o')) {
-//                     if (!isOctalDigit(current())) {
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("incomplete or invalid octal literal");
-//                     }
-
-//                     while (!atEnd() && isOctalDigit(current())) {
-//                         next();
-//                     }
-
-//                     if (isLetterOrDigit(current()) || current() == '_') {
-//                         const char invalid = current();
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("invalid octal digit", invalid); 
-//                     }
-//                 } else if (match('x')) {
-//                     if (!isHexadecimalDigit(current())) {
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("incomplete or invalid hexadecimal literal");
-//                     }
-
-//                     while (!atEnd() && isHexadecimalDigit(current())) {
-//                         next();
-//                     }
-
-//                     if (isLetterOrDigit(current()) || current() == '_') {
-//                         const char invalid = current();
-//                         while (!atEnd() && !match('\'')) {
-//                             next();
-//                         }
-
-//                         return error("invalid hexadecimal digit", invalid); 
-//                     }
-//                 } else if (isLetter(current()) || current() == '_') {
-//                     while (!atEnd() && !match('\'')) {
-//                         next();
-//                     }
-
-//                     return error("`0` should be alone or pair with `b`, `o`, or `x`");
-//                 }
-//             } else if (isDigit(c)) {
-//                 if (extractNumericLiteral() == TokenType::FLOAT_LITERAL) {
-//                     while (!atEnd() && !match('\'')) {
-//                         next();
-//                     }
-
-//                     return error("escape sequence cannot be a floating point value");
-//                 }
-//             }
-//             break;
-//     }
-
-//     if (!match('\'')) {
-//         const char invalid = current();
-//         while (!atEnd() && !match('\'')) {
-//             next();
-//         }
-
-//         return error("invalid escape sequence", invalid);
-//     }
-
-//     return TokenType::CHARACTER_LITERAL;
-// }
+        Tokenizer* tokenizer = chunk.tokenizer.get();
+        Piece piece = {tokenizer->tokens.get(), 0, size, {}};
 
-TokenType Tokenizer::extractUnrecognizedSymbol(void) {
-    while (!atEnd() && !isRecognized(current())) {
-        next();
+        if (resumed == chunk.from) {
+            for (SymbolId id = 0; id < chunk.names.size(); ++id) {
+                piece.remap.push_back(module->names.intern(chunk.names.name(id)));
+            }
+        } else if (const uint32_t first = piece.tokens->find(resumed); first < piece.tokens->size() && piece.tokens->offset(first) == resumed) {
+            piece.first = first;
+            piece.remap.assign(chunk.names.size(), NO_SYMBOL);
+
+            for (uint32_t index = first; index < piece.tokens->size(); ++index) {
+                if (const SymbolId symbol = piece.tokens->symbol(index); symbol != NO_SYMBOL && piece.remap[symbol] == NO_SYMBOL) {
+                    piece.remap[symbol] = module->names.intern(chunk.names.name(symbol));
+                }
+            }
+        } else {
+            tokenizer = relexed.emplace_back(new Tokenizer(module, module->names, resumed, chunk.to)).get();
+            tokenizer->defer_reports = true;
+            tokenizer->tokenize();
+
+            piece.tokens = tokenizer->tokens.get();
+        }
+
+        for (const Report& report : tokenizer->reports) {
+            if (report.offset >= resumed) {
+                std::cerr << report.text << std::endl;
+                has_error = true;
+            }
+        }
+
+        size += piece.tokens->size() - piece.first;
+        resumed = tokenizer->cursor - tokenizer->begin;
+
+        pieces.push_back(std::move(piece));
     }
 
-    return error("Unrecognized symbol", lexeme_buffer.at(0));
-}
+    if (has_error) {
+        return none();
+    }
 
-std::unique_ptr<TokenStream> Tokenizer::extractTokenStream(const std::unique_ptr<Module>& module) {
-    Tokenizer tokenizer(module);
-    return tokenizer.has_error ? none() : some(std::move(tokenizer.tokens));
-}
\ No newline at end of file
+    std::unique_ptr<TokenStream> tokens = std::make_unique<TokenStream>(*module->source);
+    tokens->reserve(size + 1);
+    tokens->resize(size);
+
+    {
+        std::vector<std::thread> workers;
+
+        for (const Piece& piece : pieces) {
+            workers.emplace_back([&tokens, &piece] {
+                tokens->place(*piece.tokens, piece.first, piece.at, piece.remap);
+            });
+        }
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    tokens->append(TokenType::END_OF_FILE, resumed, 0, NO_SYMBOL);
+
+    return some(tokens);
+}
@@ -0,0 +1,91 @@
+/// *==============================================================*
+///  tokensource.cpp
+/// *==============================================================*
+#include "include/tokensource.hpp"
+
+#include <stdexcept>
+
+using namespace XC;
+
+// Covers the tokens of short declarations, which stay reachable until the
+// next declaration starts, without growing
+static constexpr uint32_t INITIAL_WINDOW_SIZE = 256;
+
+TokenSource::TokenSource(const std::unique_ptr<Module>& module, Arena& arena)
+    : module(module),
+      arena(arena),
+      tokenizer(nullptr),
+      window(),
+      first(0),
+      end(0),
+      peak(0) {
+    if (module->tokens == nullptr) {
+        tokenizer = std::make_unique<Tokenizer>(module);
+        window.resize(INITIAL_WINDOW_SIZE);
+    }
+}
+
+Token TokenSource::at(const uint32_t index) {
+    if (tokenizer == nullptr) {
+        return module->tokens->at(index);
+    }
+
+    return windowAt(index);
+}
+
+TokenType TokenSource::type(const uint32_t index) {
+    if (tokenizer == nullptr) {
+        return module->tokens->type(index);
+    }
+
+    return windowAt(index).type;
+}
+
+void TokenSource::release(const uint32_t index) {
+    first = max_of(first, min_of(index, end));
+}
+
+Token* TokenSource::retain(const Token& token) {
+    return arena.make<Token>(token);
+}
+
+bool TokenSource::hasError(void) const {
+    return tokenizer != nullptr && tokenizer->hasError();
+}
+
+const Token& TokenSource::windowAt(const uint32_t index) {
+    if (index < first) {
+        throw std::out_of_range("token " + std::to_string(index) + " was released from the window");
+    }
+
+    while (index >= end) {
+        pull();
+    }
+
+    return window[index & (window.size() - 1)];
+}
+
+uint32_t TokenSource::peakWindowSize(void) const {
+    return peak;
+}
+
+void TokenSource::pull(void) {
+    if (end - first == window.size()) {
+        grow();
+    }
+
+    window[end & (window.size() - 1)] = tokenizer->nextToken();
+    ++end;
+
+    peak = max_of(peak, end - first);
+}
+
+void TokenSource::grow(void) {
+    std::vector<Token> larger(window.size() * 2);
+
+    for (uint32_t index = first; index < end; ++index) {
+        larger[index & (larger.size() - 1)] = window[index & (window.size() - 1)];
+    }
+
+    window = std::move(larger);
+}
@@ -0,0 +1,96 @@
+/// *==============================================================*
+///  typetable.cpp
+/// *==============================================================*
+#include "include/typetable.hpp"
+
+using namespace XC;
+
+bool TypeTable::Key::operator==(const Key& other) const {
+    return symbol == other.symbol && is_reference == other.is_reference && dimensions == other.dimensions;
+}
+
+size_t TypeTable::KeyHash::operator()(const Key& key) const {
+    return ((size_t) key.symbol << 32) ^ ((size_t) key.dimensions << 1) ^ (size_t) key.is_reference;
+}
+
+TypeTable::TypeTable(void)
+    : types(),
+      entries(),
+      lock() {}
+
+const DataType* TypeTable::get(const SymbolId symbol, const TokenType kind, const std::string_view name, const bool is_reference, const uint32_t dimensions) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    const auto [found, inserted] = types.try_emplace({symbol, is_reference, dimensions}, nullptr);
+
+    if (!inserted) {
+        return found->second;
+    }
+
+    Entry& entry = entries.emplace_back();
+
+    entry.name = name;
+
+    entry.type_name.index = 0;
+    entry.type_name.line = 0;
+    entry.type_name.column = 0;
+    entry.type_name.type = kind;
+    entry.type_name.lexeme = entry.name;
+    entry.type_name.symbol = symbol;
+
+    entry.type.is_reference = is_reference;
+    entry.type.type_name = &entry.type_name;
+    entry.type.dimensions = dimensions;
+
+    return found->second = &entry.type;
+}
+
+const DataType* TypeTable::get(const Token* type_name, const bool is_reference, const uint32_t dimensions) {
+    return get(type_name->symbol, type_name->type, type_name->lexeme, is_reference, dimensions);
+}
+
+const DataType* TypeTable::get(const DataType* type) {
+    if (type == nullptr) {
+        return nullptr;
+    }
+
+    return get(type->type_name, type->is_reference, type->dimensions);
+}
+
+uint32_t TypeTable::size(void) {
+    const std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
+
+void TypeTable::clear(void) {
+    const std::lock_guard<std::mutex> guard(lock);
+
+    types.clear();
+    entries.clear();
+}
+
+TypeCache::TypeCache(TypeTable& table)
+    : table(table),
+      types() {}
+
+const DataType* TypeCache::get(const SymbolId symbol, const TokenType kind, const std::string_view name, const bool is_reference, const uint32_t dimensions) {
+    const auto [found, inserted] = types.try_emplace({symbol, is_reference, dimensions}, nullptr);
+
+    if (inserted) {
+        found->second = table.get(symbol, kind, name, is_reference, dimensions);
+    }
+
+    return found->second;
+}
+
+const DataType* TypeCache::get(const Token* type_name, const bool is_reference, const uint32_t dimensions) {
+    return get(type_name->symbol, type_name->type, type_name->lexeme, is_reference, dimensions);
+}
+
+const DataType* TypeCache::get(const DataType* type) {
+    if (type == nullptr) {
+        return nullptr;
+    }
+
+    return get(type->type_name, type->is_reference, type->dimensions);
+}
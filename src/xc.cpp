@@ -7,31 +7,336 @@
 #include "include/parser.hpp"
 #include "include/analyzer.hpp"
 #include "include/cgenerator.hpp"
+#include "include/cache.hpp"
+#include "include/reparser.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
 using namespace XC;
 
-void XC::compile(const std::string target) {
+using Clock = std::chrono::steady_clock;
+
+static double millisecondsSince(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// Prints the layout of every structure and how much reordering its members saves
+static void reportLayouts(const std::unique_ptr<Module>& module) {
+    const std::vector<Structure*>& structures = module->symbols->getAllStructures();
+    uint32_t saved = 0;
+    uint32_t shrunk = 0;
+
+    for (uint32_t index = 0; index < structures.size(); ++index) {
+        const StructureLayout& layout = module->layouts->layoutOf(index);
+
+        std::cerr << "xc: struct `" << structures[index]->name->lexeme << '`';
+
+        if (!layout.is_known) {
+            std::cerr << " holds itself by value, so it has no size\n";
+            continue;
+        }
+
+        std::cerr << " is " << layout.size << " bytes, aligned to " << layout.alignment << ", with "
+                  << layout.padding << " of padding";
+
+        if (layout.packed_size < layout.size) {
+            std::cerr << ", " << layout.packed_size << " bytes with " << layout.packed_padding
+                      << " of padding reordered (-" << layout.size - layout.packed_size << ')';
+
+            saved += layout.size - layout.packed_size;
+            ++shrunk;
+        }
+
+        std::cerr << '\n';
+    }
+
+    std::cerr << "xc: reordering " << (module->options.reorder_members ? "saved " : "would save ") << saved
+              << " bytes in " << shrunk << " of " << structures.size() << " structs" << std::endl;
+}
+
+/// @return whether the module is parsed into a flat tree. The options that
+/// keep or inspect the tree between phases or compiles work on the pointer
+/// tree, and the flat tree refers to the tokens of a materialized stream.
+static bool parsesFlat(const Options& options) {
+    return options.flat_tree && !options.stream_tokens && options.cache_directory.empty()
+        && !options.incremental && !options.report_layout && !options.reorder_members;
+}
+
+/// Runs the phases after parsing and writes the output, unless it is already up to date
+/// @return `false` if the module has errors, which were reported
+static bool finish(const std::unique_ptr<Module>& module, double& analyze_time, double& generate_time, bool& written) {
+    Clock::time_point start = Clock::now();
+
+    if (module->flat != nullptr) {
+        if ((module->flat_symbols = Analyzer::validateFlatSemantics(module)) == nullptr) {
+            return false;
+        }
+    } else if ((module->symbols = Analyzer::validateSemantics(module)) == nullptr) {
+        return false;
+    }
+
+    analyze_time = millisecondsSince(start);
+
+    if (module->options.report_layout || module->options.reorder_members) {
+        module->layouts = LayoutTable::computeLayouts(*module->symbols);
+
+        if (module->options.report_layout) {
+            reportLayouts(module);
+        }
+    }
+
+    start = Clock::now();
+
+    if ((module->code = CGenerator::generateCode(module)) == nullptr) {
+        return false;
+    }
+
+    generate_time = millisecondsSince(start);
+    written = module->code->writeOut();
+
+    if (module->fingerprints != nullptr) {
+        module->fingerprints->store();
+    }
+
+    return true;
+}
+
+/// Compiles the module's source from scratch
+/// @return `false` if the source has errors, which were reported
+static bool build(const std::unique_ptr<Module>& module) {
+    const Options& options = module->options;
+    const Clock::time_point compile_start = Clock::now();
+    Clock::time_point start = compile_start;
+
+    Cache cache(module);
+    const bool cached = cache.load();
+
+    double cache_time = millisecondsSince(start);
+    bool stored = false;
+    double tokenize_time = 0;
+    double parse_time = 0;
+
+    // A cached module comes with its tokens and tree
+    if (!cached) {
+        start = Clock::now();
+
+        // When streaming, the parser pulls the tokens itself
+        if (!options.stream_tokens && (module->tokens = Tokenizer::extractTokenStream(module)) == nullptr) {
+            return false;
+        }
+
+        tokenize_time = millisecondsSince(start);
+        start = Clock::now();
+
+        if (parsesFlat(options)) {
+            if ((module->flat = Parser::getFlatTree(module)) == nullptr) {
+                return false;
+            }
+        } else if ((module->program = Parser::getProgramTree(module)) == nullptr) {
+            return false;
+        }
+
+        parse_time = millisecondsSince(start);
+        start = Clock::now();
+
+        stored = cache.store();
+
+        cache_time += millisecondsSince(start);
+    }
+
+    double analyze_time = 0;
+    double generate_time = 0;
+    bool written = false;
+
+    if (!finish(module, analyze_time, generate_time, written)) {
+        return false;
+    }
+
+    const double compile_time = millisecondsSince(compile_start);
+
+    if (options.report_stats) {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        if (module->flat != nullptr) {
+            std::cerr << "xc: " << module->flat->nodeCount() << " nodes, "
+                      << module->flat->bytesUsed() << " bytes in flat tree ("
+                      << module->flat->bytesReserved() << " reserved)\n";
+        } else {
+            std::cerr << "xc: " << module->arena.objectCount() << " nodes, "
+                      << module->arena.bytesUsed() << " bytes in arena ("
+                      << module->arena.bytesReserved() << " reserved)\n";
+        }
+
+        std::cerr << "xc: tokenize " << tokenize_time << " ms, parse " << parse_time
+                  << " ms, analyze " << analyze_time << " ms, generate " << generate_time << " ms\n";
+
+        if (module->fingerprints != nullptr) {
+            std::cerr << "xc: reused " << module->fingerprints->reusedCount() << " of "
+                      << module->symbols->getAllFunctions().size() << " functions from the last compile\n";
+        }
+
+        if (cache.isEnabled()) {
+            std::cerr << "xc: cache " << (cached ? "hit, loaded" : stored ? "miss, stored" : "miss, not stored")
+                      << " in " << cache_time << " ms\n";
+        }
+
+        std::cerr << "xc: compiled in " << compile_time << " ms, peak memory " << usage.ru_maxrss << " KiB" << std::endl;
+    }
+
+    return true;
+}
+
+bool XC::compile(const std::string target, const Options& options) {
     const std::unique_ptr<Module> module = std::make_unique<Module>();
+    module->options = options;
 
     if ((module->source = SourceFile::loadContent(target)) == nullptr) {
-        exit(EXIT_FAILURE);
+        return false;
+    }
+
+    return build(module);
+}
+
+// <*> =========================== WATCH =========================== <*>
+
+/// Reads the target into a buffer of its own. A mapping of the file would
+/// change under the module, or go away, when the file is saved again.
+static std::unique_ptr<SourceFile> readContent(const std::string& target) {
+    std::ifstream file(target, std::ios::binary);
+    std::ostringstream text;
+
+    if (!file) {
+        std::cerr << "xc: \033[31merror\033[0m: " << std::strerror(errno) << ": `" << target << '`' << std::endl;
+        return nullptr;
     }
 
-    if ((module->tokens = Tokenizer::extractTokenStream(module)) == nullptr) {
-        exit(EXIT_FAILURE);
+    text << file.rdbuf();
+
+    return SourceFile::fromText(target, text.str());
+}
+
+/// Brings a module that was built before up to date with the target's new
+/// content, reparsing only what changed
+/// @return `false` if the target has errors, which were reported
+static bool rebuild(const std::unique_ptr<Module>& module, const SourceFile& source) {
+    Clock::time_point start = Clock::now();
+
+    if (!Reparser::applyEdit(module, Edit::between(module->source->content, source.content))) {
+        return false;
     }
 
-    if ((module->program = Parser::getProgramTree(module)) == nullptr) {
-        exit(EXIT_FAILURE);
+    const double parse_time = millisecondsSince(start);
+    double analyze_time = 0;
+    double generate_time = 0;
+    bool written = false;
+
+    if (!finish(module, analyze_time, generate_time, written)) {
+        return false;
     }
 
-    if ((module->symbols = Analyzer::validateSemantics(module)) == nullptr) {
-        exit(EXIT_FAILURE);
-    } 
+    if (module->options.report_stats) {
+        std::cerr << "xc: reparse " << parse_time << " ms, analyze " << analyze_time
+                  << " ms, generate " << generate_time << " ms" << (written ? "" : ", output unchanged") << std::endl;
 
-    if ((module->code = CGenerator::generateCode(module)) == nullptr) {
-        exit(EXIT_FAILURE);
+        if (module->fingerprints != nullptr) {
+            std::cerr << "xc: reused " << module->fingerprints->reusedCount() << " of "
+                      << module->symbols->getAllFunctions().size() << " functions from the last compile" << std::endl;
+        }
     }
 
-    module->code->writeOut();
-}
\ No newline at end of file
+    return true;
+}
+
+bool XC::watch(const std::string target, const Options& options) {
+    const size_t slash = target.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : target.substr(0, slash + 1);
+    const std::string name = target.substr(slash + 1);
+
+    // Editors often save by renaming a new file over the old one, which a
+    // watch on the file itself would lose track of
+    const int inotify = inotify_init1(IN_CLOEXEC);
+
+    if (inotify < 0 || inotify_add_watch(inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "xc: \033[31merror\033[0m: " << std::strerror(errno) << ": `" << directory << '`' << std::endl;
+        return false;
+    }
+
+    // Edits are applied to the pointer tree
+    Options watched = options;
+    watched.flat_tree = false;
+
+    std::unique_ptr<Module> module = std::make_unique<Module>();
+    module->options = watched;
+
+    if ((module->source = readContent(target)) != nullptr) {
+        build(module);
+    }
+
+    // Replaced declarations and every analysis leave their nodes in the
+    // arena, so the module is built from scratch once it has doubled
+    size_t built_size = module->arena.bytesUsed();
+
+    std::cerr << "xc: watching `" << target << '`' << std::endl;
+
+    alignas(inotify_event) char events[4096];
+
+    for (;;) {
+        const ssize_t length = read(inotify, events, sizeof(events));
+
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            std::cerr << "xc: \033[31merror\033[0m: " << std::strerror(errno) << ": `" << directory << '`' << std::endl;
+            return false;
+        }
+
+        bool changed = false;
+
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = (const inotify_event*) (events + offset);
+            changed |= event->len > 0 && name == event->name;
+            offset += sizeof(inotify_event) + event->len;
+        }
+
+        if (!changed) {
+            continue;
+        }
+
+        const Clock::time_point start = Clock::now();
+        std::unique_ptr<SourceFile> source = readContent(target);
+
+        if (source == nullptr) {
+            continue;
+        }
+
+        // Saving without changes is not worth a line
+        if (module->source != nullptr && module->source->content == source->content) {
+            continue;
+        }
+
+        bool built;
+
+        if (module->source == nullptr || module->arena.bytesUsed() > 2 * built_size) {
+            module = std::make_unique<Module>();
+            module->options = watched;
+            module->source = std::move(source);
+
+            built = build(module);
+            built_size = module->arena.bytesUsed();
+        } else {
+            built = rebuild(module, *source);
+        }
+
+        std::cerr << "xc: " << (built ? "rebuilt" : "failed") << " in " << millisecondsSince(start) << " ms" << std::endl;
+    }
+}
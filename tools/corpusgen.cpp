@@ -0,0 +1,544 @@
+/// *==============================================================*
+///  corpusgen.cpp
+///
+///  Generates synthetic XC programs for scalability testing. The
+///  output is built from units of one struct with its member
+///  functions followed by free functions, repeated until the count
+///  or size asked for is reached, and ended by a `main`. Programs
+///  are valid unless an error rate is given, in which case that
+///  fraction of functions gets exactly one lexical, syntax or
+///  semantic error.
+///
+///  usage: corpusgen [OPTIONS] OUTPUT
+/// *==============================================================*
+#include "../src/include/common.hpp"
+
+#include <cstdio>
+#include <random>
+
+struct Settings {
+    uint64_t structs = 100;
+    uint32_t members = 4;
+    uint32_t methods = 4; // member functions per struct
+    uint32_t functions = 2; // free functions per struct
+    uint32_t statements = 8; // per function body
+    uint32_t depth = 4; // of expressions
+    uint32_t nesting = 2; // of blocks that may hold loops and conditionals
+    double comments = 0.1; // chance of a comment before a statement
+    double errors = 0; // chance of a function having an error
+    uint64_t size = 0; // bytes, replaces `structs` when given
+    uint64_t seed = 1;
+};
+
+struct Callable {
+    std::string name;
+    uint32_t arity;
+};
+
+class Generator {
+public:
+    Generator(const Settings& settings, std::FILE* output)
+        : settings(settings),
+          output(output),
+          random(settings.seed) {}
+
+    void generate(void) {
+        out.append("// Generated by corpusgen\n\n");
+
+        for (uint64_t unit = 0; settings.size > 0 ? written + out.size() < settings.size : unit < settings.structs; ++unit) {
+            generateUnit(unit);
+
+            // Flushing per unit keeps memory flat for outputs of any size
+            flush();
+        }
+
+        generateMain();
+        flush();
+
+        std::fprintf(
+            stderr,
+            "corpusgen: %llu bytes, %llu structs, %llu functions, %llu statements, %llu errors\n",
+            (unsigned long long) written,
+            (unsigned long long) struct_count,
+            (unsigned long long) function_count,
+            (unsigned long long) statement_count,
+            (unsigned long long) error_count
+        );
+    }
+
+private:
+    enum class Error {
+        NONE,
+        LEXICAL,
+        SYNTAX,
+        SEMANTIC
+    };
+
+    const Settings& settings;
+    std::FILE* output;
+    std::mt19937_64 random;
+
+    std::string out;
+    uint64_t written = 0;
+
+    uint64_t struct_count = 0;
+    uint64_t function_count = 0;
+    uint64_t statement_count = 0;
+    uint64_t error_count = 0;
+
+    std::vector<Callable> free_functions; // callable from any later function
+    std::vector<Callable> methods; // of the struct being generated
+    std::vector<std::pair<std::string, Callable>> objects; // structs and their first method
+
+    // State of the function being generated
+    std::string owner;
+    std::vector<std::string> variables; // ints in scope
+    std::vector<std::string> counters; // loop counters in scope, only read
+    uint32_t variable_count = 0;
+    uint32_t indention = 0;
+    Error pending_error = Error::NONE;
+
+    void flush(void) {
+        std::fwrite(out.data(), 1, out.size(), output);
+        written += out.size();
+        out.clear();
+    }
+
+    uint32_t below(const uint32_t bound) {
+        return bound == 0 ? 0 : random() % bound;
+    }
+
+    bool chance(const double probability) {
+        return std::generate_canonical<double, 32>(random) < probability;
+    }
+
+    void line(const std::string& text) {
+        out.append(indention * 4, ' ');
+        out.append(text);
+        out.push_back('\n');
+    }
+
+    std::string newVariable(void) {
+        return "v" + std::to_string(variable_count++);
+    }
+
+    // <*> ================================================================ <*>
+
+    void generateUnit(const uint64_t unit) {
+        const std::string name = "S" + std::to_string(unit);
+
+        line("struct " + name + " {");
+        ++indention;
+        for (uint32_t i = 0; i < settings.members; ++i) {
+            line("int f" + std::to_string(i) + ";");
+        }
+        --indention;
+        line("}");
+        line("");
+
+        ++struct_count;
+
+        owner = name;
+        methods.clear();
+
+        for (uint32_t i = 0; i < settings.methods; ++i) {
+            Callable method = {"m" + std::to_string(unit) + "_" + std::to_string(i), 1 + below(3)};
+            generateFunction(method);
+            methods.push_back(method);
+        }
+
+        if (!methods.empty()) {
+            objects.push_back({name, methods.front()});
+        }
+
+        owner.clear();
+        methods.clear();
+
+        for (uint32_t i = 0; i < settings.functions; ++i) {
+            Callable function = {"f" + std::to_string(unit) + "_" + std::to_string(i), 1 + below(3)};
+            generateFunction(function);
+            free_functions.push_back(function);
+        }
+    }
+
+    void generateFunction(const Callable& function) {
+        variables.clear();
+        counters.clear();
+        variable_count = 0;
+
+        std::string parameters;
+        for (uint32_t i = 0; i < function.arity; ++i) {
+            const std::string parameter = newVariable();
+            parameters.append((i > 0 ? ", int " : "int ") + parameter);
+            variables.push_back(parameter);
+        }
+
+        pending_error = Error::NONE;
+        if (settings.statements > 0 && settings.errors > 0 && chance(settings.errors)) {
+            pending_error = Error(1 + below(3));
+            ++error_count;
+        }
+
+        line((owner.empty() ? "" : owner + " :: ") + "int " + function.name + "(" + parameters + ") {");
+        ++indention;
+
+        for (uint32_t i = 0; i < settings.statements; ++i) {
+            generateStatement(0, i == 0);
+        }
+
+        line("return " + intExpression(settings.depth) + ";");
+
+        --indention;
+        line("}");
+        line("");
+
+        ++function_count;
+    }
+
+    void generateMain(void) {
+        variables.clear();
+        counters.clear();
+        variable_count = 0;
+        pending_error = Error::NONE;
+
+        line("int main(void) {");
+        ++indention;
+
+        const std::string result = newVariable();
+        line("int " + result + " = 0;");
+        variables.push_back(result);
+
+        for (uint32_t i = 0; i < settings.statements && !free_functions.empty(); ++i) {
+            line(result + " += " + call(free_functions[below(free_functions.size())]) + ";");
+        }
+
+        line("return " + result + ";");
+
+        --indention;
+        line("}");
+    }
+
+    // <*> ================================================================ <*>
+
+    void generateComment(void) {
+        if (below(2) == 0) {
+            line("// " + std::to_string(random()) + " keeps the tokenizer busy");
+        } else {
+            line("/* " + std::to_string(random()) + " spans");
+            line("   more than one line */");
+        }
+    }
+
+    void generateStatement(const uint32_t nesting, const bool first) {
+        if (settings.comments > 0 && chance(settings.comments)) {
+            generateComment();
+        }
+
+        ++statement_count;
+
+        // A function with an error gets it in its first statement
+        if (pending_error != Error::NONE) {
+            generateError();
+            return;
+        }
+
+        // Past two levels only the first statement of a block is a loop, so the
+        // output grows with the nesting and not exponentially
+        const uint32_t kind = nesting < 2 ? below(9) : nesting < settings.nesting && first ? 7 + below(2) : below(6);
+
+        if (kind < 2 || variables.empty()) {
+            const std::string variable = newVariable();
+            line("int " + variable + " = " + intExpression(settings.depth) + ";");
+            variables.push_back(variable);
+        } else if (kind < 4) {
+            static const char* const operators[] = {"=", "+=", "-=", "*=", "&=", "|=", "^="};
+            line(assignable() + " " + operators[below(7)] + " " + intExpression(settings.depth) + ";");
+        } else if (kind == 4) {
+            line((below(2) == 0 ? "++" : "--") + variables[below(variables.size())] + ";");
+        } else if (kind == 5) {
+            generateObject();
+        } else if (kind == 6) {
+            generateConditional(nesting);
+        } else if (kind == 7) {
+            generateWhile(nesting);
+        } else {
+            generateFor(nesting);
+        }
+    }
+
+    void generateObject(void) {
+        if (objects.empty()) {
+            line(assignable() + " += " + intExpression(settings.depth) + ";");
+            return;
+        }
+
+        const std::pair<std::string, Callable>& object = objects[below(objects.size())];
+        const std::string instance = newVariable();
+        const std::string result = newVariable();
+
+        line(object.first + " " + instance + ";");
+        line("int " + result + " = " + instance + "." + call(object.second) + ";");
+
+        variables.push_back(result);
+    }
+
+    void generateError(void) {
+        const std::string variable = newVariable();
+
+        switch (pending_error) {
+            case Error::LEXICAL:
+                line("int " + variable + " = 1 $ 2;");
+                break;
+            case Error::SYNTAX:
+                line("int " + variable + " = (1 + 2;");
+                break;
+            default:
+                line("bool " + variable + " = " + intExpression(1) + ";");
+                break;
+        }
+
+        pending_error = Error::NONE;
+    }
+
+    void generateBlock(const uint32_t nesting) {
+        const size_t in_scope = variables.size();
+        const size_t counters_in_scope = counters.size();
+
+        ++indention;
+        for (uint32_t i = 0, count = 1 + below(3); i < count; ++i) {
+            generateStatement(nesting + 1, i == 0);
+        }
+        --indention;
+
+        variables.resize(in_scope);
+        counters.resize(counters_in_scope);
+    }
+
+    /// @return a variable or loop counter in scope
+    const std::string& readable(void) {
+        const uint32_t pick = below(variables.size() + counters.size());
+        return pick < variables.size() ? variables[pick] : counters[pick - variables.size()];
+    }
+
+    void generateConditional(const uint32_t nesting) {
+        line("if (" + condition(settings.depth) + ") {");
+        generateBlock(nesting);
+
+        if (below(2) == 0) {
+            line("} else {");
+            generateBlock(nesting);
+        }
+
+        line("}");
+    }
+
+    void generateWhile(const uint32_t nesting) {
+        // Declared outside so the loop terminates
+        const std::string counter = newVariable();
+        line("int " + counter + " = 0;");
+        counters.push_back(counter);
+
+        line("while (" + counter + " < " + std::to_string(1 + below(16)) + ") {");
+        generateBlock(nesting);
+
+        ++indention;
+        if (below(4) == 0) {
+            line("if (" + condition(1) + ") {");
+            line("    break;");
+            line("}");
+        }
+        line(counter + " += 1;");
+        --indention;
+
+        line("}");
+    }
+
+    void generateFor(const uint32_t nesting) {
+        const std::string counter = newVariable();
+
+        line("for (int " + counter + " = 0; " + counter + " < " + std::to_string(1 + below(16)) + "; ++" + counter + ") {");
+        counters.push_back(counter);
+        generateBlock(nesting);
+        counters.pop_back(); // in C the counter ends with the loop
+        line("}");
+    }
+
+    // <*> ================================================================ <*>
+
+    std::string assignable(void) {
+        if (!owner.empty() && below(3) == 0) {
+            return "self.f" + std::to_string(below(settings.members));
+        }
+
+        return variables[below(variables.size())];
+    }
+
+    std::string literal(void) {
+        char text[16];
+        std::snprintf(text, sizeof(text), below(4) == 0 ? "0x%X" : "%u", below(1000));
+
+        return text;
+    }
+
+    std::string call(const Callable& function) {
+        std::string arguments;
+
+        for (uint32_t i = 0; i < function.arity; ++i) {
+            arguments.append((i > 0 ? ", " : "") + (variables.empty() ? literal() : readable()));
+        }
+
+        return function.name + "(" + arguments + ")";
+    }
+
+    std::string intOperand(void) {
+        switch (below(8)) {
+            case 0:
+            case 1:
+                return literal();
+            case 2:
+                if (!owner.empty() && settings.members > 0) {
+                    return "self.f" + std::to_string(below(settings.members));
+                }
+                return literal();
+            case 3:
+                // Only earlier functions are called, so nothing recurses
+                if (!owner.empty() && !methods.empty()) {
+                    return "self." + call(methods[below(methods.size())]);
+                }
+                if (!free_functions.empty()) {
+                    return call(free_functions[below(free_functions.size())]);
+                }
+                return literal();
+            default:
+                return variables.empty() ? literal() : readable();
+        }
+    }
+
+    std::string intExpression(const uint32_t depth) {
+        if (depth == 0 || below(4) == 0) {
+            return intOperand();
+        }
+
+        switch (below(6)) {
+            case 0:
+                // The analyzer only takes a negated number
+                return "(-" + literal() + ")";
+            case 1:
+                return "~(" + intExpression(depth - 1) + ")";
+            case 2:
+                // Only by constants, so nothing divides by zero
+                return "(" + intExpression(depth - 1) + (below(2) == 0 ? " / " : " % ") + std::to_string(1 + below(9)) + ")";
+            default: {
+                static const char* const operators[] = {" + ", " - ", " * ", " & ", " | ", " ^ "};
+                return "(" + intExpression(depth - 1) + operators[below(6)] + intExpression(depth - 1) + ")";
+            }
+        }
+    }
+
+    std::string condition(const uint32_t depth) {
+        static const char* const comparisons[] = {" < ", " > ", " <= ", " >= ", " == ", " != "};
+
+        if (depth <= 1 || below(2) == 0) {
+            return intExpression(depth) + comparisons[below(6)] + intExpression(depth);
+        }
+
+        switch (below(3)) {
+            case 0:
+                return "!(" + condition(depth - 1) + ")";
+            case 1:
+                return "(" + condition(depth - 1) + ") && (" + condition(depth - 1) + ")";
+            default:
+                return "(" + condition(depth - 1) + ") || (" + condition(depth - 1) + ")";
+        }
+    }
+};
+
+static void usage(void) {
+    std::cerr << "usage:\n\tcorpusgen [OPTIONS] OUTPUT\n\n"
+              << "OUTPUT is a file, or `-` for stdout\n\n"
+              << "options:\n"
+              << "\t--structs N\tnumber of structs (default 100)\n"
+              << "\t--members N\tint members per struct (default 4)\n"
+              << "\t--methods N\tmember functions per struct (default 4)\n"
+              << "\t--functions N\tfree functions per struct (default 2)\n"
+              << "\t--statements N\ttop-level statements per function body (default 8)\n"
+              << "\t--depth N\tmaximum expression depth (default 4)\n"
+              << "\t--nesting N\tdepth loops are nested to, at least 2 (default 2)\n"
+              << "\t--comments P\tchance of a comment before each statement (default 0.1)\n"
+              << "\t--errors P\tchance of a function having one error (default 0)\n"
+              << "\t--size N[K|M|G]\tkeep adding structs until the output is this big\n"
+              << "\t--seed N\tseed of the generator (default 1)" << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+static uint64_t parseSize(const char* text) {
+    char* suffix = nullptr;
+    const uint64_t value = std::strtoull(text, &suffix, 10);
+
+    switch (*suffix) {
+        case 'k': case 'K': return value << 10;
+        case 'm': case 'M': return value << 20;
+        case 'g': case 'G': return value << 30;
+        default: return value;
+    }
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+    std::string target;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument(argv[i]);
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (argument.size() > 2 && argument.compare(0, 2, "--") == 0 && value == nullptr) {
+            usage();
+        }
+
+        if (argument == "--structs") {
+            settings.structs = std::strtoull(value, nullptr, 10);
+        } else if (argument == "--members") {
+            settings.members = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--methods") {
+            settings.methods = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--functions") {
+            settings.functions = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--statements") {
+            settings.statements = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--depth") {
+            settings.depth = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--nesting") {
+            settings.nesting = std::strtoul(value, nullptr, 10);
+        } else if (argument == "--comments") {
+            settings.comments = std::strtod(value, nullptr);
+        } else if (argument == "--errors") {
+            settings.errors = std::strtod(value, nullptr);
+        } else if (argument == "--size") {
+            settings.size = parseSize(value);
+        } else if (argument == "--seed") {
+            settings.seed = std::strtoull(value, nullptr, 10);
+        } else if (target.empty() && (argument == "-" || argument[0] != '-')) {
+            target = argument;
+            continue;
+        } else {
+            usage();
+        }
+
+        ++i;
+    }
+
+    if (target.empty()) {
+        usage();
+    }
+
+    std::FILE* output = (target == "-") ? stdout : std::fopen(target.c_str(), "wb");
+
+    if (output == nullptr) {
+        std::cerr << "corpusgen: could not open `" << target << '`' << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Generator(settings, output).generate();
+
+    return (output == stdout || std::fclose(output) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
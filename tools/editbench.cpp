@@ -0,0 +1,218 @@
+/// *==============================================================*
+///  editbench.cpp
+///
+///  Benchmark and check of incremental reparsing. A file is compiled
+///  once, then small random edits are applied to it one after the
+///  other: digits changed, spaces and lines inserted, and `;`s or
+///  identifiers broken and then restored on the next edit. Each
+///  edit is reparsed and analyzed incrementally and timed, and the
+///  diagnostics and generated code are compared with those of the
+///  edited text compiled from scratch.
+///
+///  usage: editbench FILE [EDITS] [SEED]
+/// *==============================================================*
+#include "../src/include/xc.hpp"
+#include "../src/include/tokenizer.hpp"
+#include "../src/include/parser.hpp"
+#include "../src/include/analyzer.hpp"
+#include "../src/include/cgenerator.hpp"
+#include "../src/include/reparser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+
+using namespace XC;
+
+using Clock = std::chrono::steady_clock;
+
+static double millisecondsSince(const Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Outcome {
+    std::string diagnostics;
+    std::string code; // empty -> did not compile
+};
+
+/// Runs the phases after parsing, or all of them when `parse` is set
+static Outcome finish(const std::unique_ptr<Module>& module, const bool parse, double* analyze_time) {
+    std::ostringstream diagnostics;
+    std::streambuf* const console = std::cerr.rdbuf(diagnostics.rdbuf());
+
+    Outcome outcome;
+
+    bool ok = !parse || ((module->tokens = Tokenizer::extractTokenStream(module)) != nullptr
+                         && (module->program = Parser::getProgramTree(module)) != nullptr);
+
+    if (ok) {
+        const Clock::time_point start = Clock::now();
+        ok = (module->symbols = Analyzer::validateSemantics(module)) != nullptr;
+
+        if (analyze_time != nullptr) {
+            *analyze_time = millisecondsSince(start);
+        }
+    }
+
+    if (ok && (module->code = CGenerator::generateCode(module)) != nullptr) {
+        outcome.code = std::string(module->code->content);
+    }
+
+    std::cerr.rdbuf(console);
+    outcome.diagnostics = diagnostics.str();
+
+    return outcome;
+}
+
+/// @return a random offset of the content at which `accept` holds, or the size if there is none
+template <typename Predicate>
+static uint32_t pick(const std::string_view content, std::mt19937_64& random, Predicate accept) {
+    for (int attempt = 0; attempt < 10000; ++attempt) {
+        const uint32_t offset = random() % content.size();
+
+        if (accept(offset)) {
+            return offset;
+        }
+    }
+
+    return content.size();
+}
+
+static double percentile(std::vector<double> times, const double fraction) {
+    if (times.empty()) {
+        return 0;
+    }
+
+    std::sort(times.begin(), times.end());
+    return times[(size_t) (fraction * (times.size() - 1))];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: editbench FILE [EDITS] [SEED]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t edits = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    std::mt19937_64 random(argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1);
+
+    const std::unique_ptr<Module> module = std::make_unique<Module>();
+
+    if ((module->source = SourceFile::loadContent(argv[1])) == nullptr) {
+        return EXIT_FAILURE;
+    }
+
+    if (finish(module, true, nullptr), module->program == nullptr) {
+        std::cerr << "editbench: the file has to parse before it is edited" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << module->source->lineCount() << " lines, " << module->program->declarations.size() << " declarations\n";
+
+    std::vector<double> reparse_times;
+    std::vector<double> analyze_times;
+    uint32_t mismatches = 0;
+    uint32_t failures = 0;
+
+    bool undoing = false; // whether the next edit restores what the previous one broke
+    std::string undo;
+    uint32_t undo_at = 0;
+    uint32_t undo_length = 0;
+
+    for (uint32_t i = 0; i < edits; ++i) {
+        const std::string_view content = module->source->content;
+        std::string replacement;
+        Edit edit = {0, 0, std::string_view()};
+
+        if (undoing) {
+            replacement = undo;
+            edit = {undo_at, undo_at + undo_length, std::string_view()};
+            undoing = false;
+        } else {
+            const auto isWord = [&](const uint32_t at) { return std::isalnum(content[at]) || content[at] == '_'; };
+            const auto isDigit = [&](const uint32_t at) {
+                // a number of one digit, so the edit cannot rename anything
+                return std::isdigit(content[at]) && at > 0 && !isWord(at - 1) && at + 1 < content.size() && !isWord(at + 1);
+            };
+            const auto isSpace = [&](const uint32_t at) { return content[at] == ' '; };
+            const auto isNewline = [&](const uint32_t at) { return content[at] == '\n'; };
+            const auto isSemiColon = [&](const uint32_t at) { return content[at] == ';'; };
+            const auto isLetter = [&](const uint32_t at) { return content[at] >= 'a' && content[at] <= 'z'; };
+
+            switch (random() % 5) {
+                case 0: {
+                    const uint32_t at = pick(content, random, isDigit);
+                    replacement = std::string(1, (char) ('0' + (content[at] - '0' + 1 + random() % 9) % 10));
+                    edit = {at, min_of(at + 1, (uint32_t) content.size()), std::string_view()};
+                    break;
+                }
+                case 1:
+                    edit.begin = edit.end = pick(content, random, isSpace);
+                    replacement = " ";
+                    break;
+                case 2:
+                    edit.begin = edit.end = pick(content, random, isNewline);
+                    replacement = "\n";
+                    break;
+                case 3:
+                    edit.begin = pick(content, random, isSemiColon);
+                    edit.end = min_of(edit.begin + 1, (uint32_t) content.size());
+                    undoing = true;
+                    undo = std::string(content.substr(edit.begin, edit.end - edit.begin));
+                    undo_at = edit.begin;
+                    undo_length = 0;
+                    break;
+                default:
+                    edit.begin = edit.end = pick(content, random, isLetter);
+                    replacement = "q";
+                    undoing = true;
+                    undo.clear();
+                    undo_at = edit.begin;
+                    undo_length = 1;
+                    break;
+            }
+        }
+
+        edit.replacement = replacement;
+
+        std::ostringstream diagnostics;
+        std::streambuf* const console = std::cerr.rdbuf(diagnostics.rdbuf());
+
+        const Clock::time_point start = Clock::now();
+        const bool parsed = Reparser::applyEdit(module, edit);
+        reparse_times.push_back(millisecondsSince(start));
+
+        std::cerr.rdbuf(console);
+
+        double analyze_time = 0;
+        Outcome incremental = parsed ? finish(module, false, &analyze_time) : Outcome();
+        incremental.diagnostics = diagnostics.str() + incremental.diagnostics;
+
+        if (parsed) {
+            analyze_times.push_back(analyze_time);
+        }
+
+        if (incremental.code.empty()) {
+            ++failures;
+        }
+
+        const std::unique_ptr<Module> fresh = std::make_unique<Module>();
+        fresh->source = SourceFile::fromText(module->source->filename, std::string(module->source->content));
+
+        const Outcome expected = finish(fresh, true, nullptr);
+
+        if (incremental.diagnostics != expected.diagnostics || incremental.code != expected.code) {
+            std::cout << "edit " << i << " at " << edit.begin << " differs from a full compile\n";
+            ++mismatches;
+        }
+    }
+
+    std::cout << edits << " edits, " << failures << " left errors, " << mismatches << " mismatches\n"
+              << "reparse ms: median " << percentile(reparse_times, 0.5) << ", p90 " << percentile(reparse_times, 0.9)
+              << ", max " << percentile(reparse_times, 1) << '\n'
+              << "analyze ms: median " << percentile(analyze_times, 0.5) << ", p90 " << percentile(analyze_times, 0.9)
+              << ", max " << percentile(analyze_times, 1) << std::endl;
+
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
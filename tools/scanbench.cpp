@@ -0,0 +1,113 @@
+/// *==============================================================*
+///  scanbench.cpp
+///
+///  Microbenchmark of the tokenizer's run scanners. Every scanner
+///  level available on this CPU is run over the same buffers of
+///  whitespace and identifier runs of increasing length.
+///
+///  usage: scanbench [MEGABYTES]
+/// *==============================================================*
+#include "../src/include/scan.hpp"
+
+#include <chrono>
+
+using namespace XC;
+
+/// Fills `size` bytes with runs of `run` characters taken from `fill`,
+/// each run ended by `stop`.
+static std::string makeRuns(const size_t size, const size_t run, const char* fill, const char stop) {
+    const size_t fill_length = std::char_traits<char>::length(fill);
+
+    std::string buffer;
+    buffer.reserve(size + run + 1);
+
+    while (buffer.size() < size) {
+        for (size_t i = 0; i < run; ++i) {
+            buffer.push_back(fill[i % fill_length]);
+        }
+
+        buffer.push_back(stop);
+    }
+
+    return buffer;
+}
+
+/// @return the time in nanoseconds per byte to scan through the buffer
+static double measure(const std::string& buffer, const char* (*skip)(const char*, const char*)) {
+    const char* const end = buffer.data() + buffer.size();
+
+    size_t runs = 0;
+    double best = 0;
+
+    for (int round = 0; round < 5; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (const char* c = buffer.data(); c < end; ++c) {
+            c = skip(c, end);
+            ++runs;
+        }
+
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    // Keeps the loop from being optimized away
+    if (runs == 0) {
+        std::cerr << "no runs" << std::endl;
+    }
+
+    return best / buffer.size();
+}
+
+int main(int argc, char** argv) {
+    const size_t size = ((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 64) << 20;
+
+    const Scan::Level supported = Scan::supported();
+
+    std::cout << "supported: " << Scan::levelName(supported) << '\n';
+    std::cout << "ns/byte        run";
+
+    for (Scan::Level level = Scan::Level::SCALAR; level <= supported; level = Scan::Level((uint8_t) level + 1)) {
+        std::cout << "  " << std::string(8 - std::char_traits<char>::length(Scan::levelName(level)), ' ') << Scan::levelName(level);
+    }
+
+    std::cout << "  speedup" << std::endl;
+
+    for (const char* kind : {"whitespace", "identifier"}) {
+        const bool whitespace = kind[0] == 'w';
+
+        for (const size_t run : {4, 8, 16, 32, 64, 256}) {
+            const std::string buffer = whitespace ? makeRuns(size, run, "    \t   \n", 'x') : makeRuns(size, run, "abc_XYZ_019_", ';');
+
+            std::cout << kind << std::string(11 - std::char_traits<char>::length(kind), ' ');
+            std::cout << std::string(run < 10 ? 2 : (run < 100 ? 1 : 0), ' ') << run;
+
+            double scalar = 0;
+            double best = 0;
+
+            for (Scan::Level level = Scan::Level::SCALAR; level <= supported; level = Scan::Level((uint8_t) level + 1)) {
+                const Scan::Scanners& scanners = Scan::at(level);
+                const double time = measure(buffer, whitespace ? scanners.skip_whitespace : scanners.skip_identifier);
+
+                if (level == Scan::Level::SCALAR) {
+                    scalar = time;
+                }
+
+                best = time;
+
+                char cell[16];
+                std::snprintf(cell, sizeof(cell), "%10.3f", time);
+                std::cout << cell;
+            }
+
+            char cell[16];
+            std::snprintf(cell, sizeof(cell), "%8.2fx", scalar / best);
+            std::cout << cell << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}